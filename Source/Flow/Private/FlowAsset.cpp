@@ -2,9 +2,12 @@
 
 #include "FlowAsset.h"
 
+#include "FlowCustomVersion.h"
+#include "FlowLogChannels.h"
 #include "FlowSettings.h"
 #include "FlowSubsystem.h"
 
+#include "Nodes/FlowLightweightNode.h"
 #include "Nodes/FlowNode.h"
 #include "Nodes/Route/FlowNode_CustomInput.h"
 #include "Nodes/Route/FlowNode_CustomOutput.h"
@@ -17,10 +20,14 @@
 
 #if WITH_EDITOR
 #include "FlowMessageLog.h"
-#include "FlowLogChannels.h"
 
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
+#include "ProfilingDebugging/CookStats.h"
+#include "UObject/ObjectSaveContext.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION > 3
+#include "Cook/CookDependency.h"
+#endif
 #endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowAsset)
@@ -28,19 +35,45 @@
 #if WITH_EDITOR
 FString UFlowAsset::ValidationError_NodeClassNotAllowed = TEXT("Node class {0} is not allowed in this asset.");
 FString UFlowAsset::ValidationError_NullNodeInstance = TEXT("Node with GUID {0} is NULL");
+FString UFlowAsset::ValidationWarning_UnreachableNode = TEXT("Node {0} can't be reached from any entry node.");
+FString UFlowAsset::ValidationWarning_UnreachableNodeStripped = TEXT("Node {0} can't be reached from any entry node, it will be removed from cooked asset.");
+#endif
+
+#if ENABLE_COOK_STATS
+namespace FlowAssetCookStats
+{
+	static int32 NumCookedNodes = 0;
+	static int32 NumStrippedNodes = 0;
+	static int32 NumInlinedSubGraphs = 0;
+
+	// package is saved once per cooked platform, but stats are counted once per asset
+	static TSet<FName> CountedPackages;
+
+	static FCookStatsManager::FAutoRegisterCallback RegisterCookStats([](FCookStatsManager::AddStatFuncRef AddStat)
+	{
+		AddStat(TEXT("Flow.Nodes"), FCookStatsManager::CreateKeyValueArray(
+			TEXT("NodesBeforeStripping"), NumCookedNodes + NumStrippedNodes,
+			TEXT("NodesCooked"), NumCookedNodes,
+			TEXT("UnreachableNodesRemoved"), NumStrippedNodes,
+			TEXT("SubGraphsInlined"), NumInlinedSubGraphs));
+	});
+}
 #endif
 
 UFlowAsset::UFlowAsset(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bWorldBound(true)
+	, MaxPooledInstances(0)
 #if WITH_EDITOR
 	, FlowGraph(nullptr)
 #endif
 	, AllowedNodeClasses({UFlowNode::StaticClass()})
 	, AllowedInSubgraphNodeClasses({UFlowNode_SubGraph::StaticClass()})
 	, bStartNodePlacedAsGhostNode(false)
+	, bNodeConnectionsStripped(false)
 	, TemplateAsset(nullptr)
 	, FinishPolicy(EFlowFinishPolicy::Keep)
+	, bOwnerContextCached(false)
 {
 	if (!AssetGuid.IsValid())
 	{
@@ -50,6 +83,19 @@ UFlowAsset::UFlowAsset(const FObjectInitializer& ObjectInitializer)
 	ExpectedOwnerClass = UFlowSettings::Get()->GetDefaultExpectedOwnerClass();
 }
 
+void UFlowAsset::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FFlowCustomVersion::GUID);
+
+	Super::Serialize(Ar);
+
+	// assets saved before this version are compiled on the first use
+	if (Ar.CustomVer(FFlowCustomVersion::GUID) >= FFlowCustomVersion::CompiledGraphSerializedByAsset)
+	{
+		FFlowCompiledGraph::StaticStruct()->SerializeItem(Ar, &CompiledGraph, nullptr);
+	}
+}
+
 #if WITH_EDITOR
 void UFlowAsset::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
 {
@@ -105,6 +151,289 @@ void UFlowAsset::PostLoad()
 	}
 }
 
+void UFlowAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	if (SaveContext.IsCooking())
+	{
+		if (UFlowSettings::Get()->bStripUnreachableNodesOnCook)
+		{
+			StripUnreachableNodes();
+		}
+
+		// unreachable Sub Graph nodes are already removed, there's no point in inlining them
+		InlineSubGraphs();
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION > 3
+		// cooked asset contains copies of inlined nodes, so it has to be cooked again whenever the Sub Graph asset changes
+		for (const UFlowNode_SubGraph* SubGraphNode : CookInlinedSubGraphs)
+		{
+			SaveContext.AddCookBuildDependency(UE::Cook::FCookDependency::Package(SubGraphNode->Asset.ToSoftObjectPath().GetLongPackageFName()));
+		}
+#endif
+
+#if ENABLE_COOK_STATS
+		bool bAlreadyCounted = false;
+		FlowAssetCookStats::CountedPackages.Add(GetPackage()->GetFName(), &bAlreadyCounted);
+		if (!bAlreadyCounted)
+		{
+			FlowAssetCookStats::NumCookedNodes += Nodes.Num() - InlinedNodes.Num();
+			FlowAssetCookStats::NumStrippedNodes += CookStrippedNodes.Num();
+			FlowAssetCookStats::NumInlinedSubGraphs += CookInlinedSubGraphs.Num();
+		}
+#endif
+	}
+
+	// cooked game instantiates graph from the compiled data
+	CompileGraph();
+
+	if (SaveContext.IsCooking() && CompiledGraph.IsCompiled())
+	{
+		StripNodeConnections();
+	}
+}
+
+void UFlowAsset::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
+{
+	Super::PostSaveRoot(ObjectSaveContext);
+
+	if (bNodeConnectionsStripped || CookStrippedNodes.Num() > 0 || CookInlinedSubGraphs.Num() > 0)
+	{
+		RestoreNodeConnections();
+		RestoreInlinedSubGraphs();
+		RestoreStrippedNodes();
+		CompileGraph();
+	}
+}
+
+void UFlowAsset::GetUnreachableNodes(TArray<FGuid>& OutNodeGuids) const
+{
+	TSet<FGuid> ReachedNodes;
+	TArray<const UFlowNode*> NodesToVisit;
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value && Node.Value->IsEntryNode())
+		{
+			ReachedNodes.Add(Node.Key);
+			NodesToVisit.Add(Node.Value);
+		}
+	}
+
+	while (NodesToVisit.Num() > 0)
+	{
+		const UFlowNode* Node = NodesToVisit.Pop(false);
+
+		// same rule as UFlowNode::TriggerOutput, only connections of existing output pins are followed
+		for (const FFlowPin& OutputPin : Node->OutputPins)
+		{
+			TArray<FConnectedPin> Connections;
+			Node->GetConnections(OutputPin.PinName, Connections);
+
+			for (const FConnectedPin& Connection : Connections)
+			{
+				UFlowNode* const* ConnectedNode = Nodes.Find(Connection.NodeGuid);
+				if (ConnectedNode && *ConnectedNode && !ReachedNodes.Contains(Connection.NodeGuid))
+				{
+					ReachedNodes.Add(Connection.NodeGuid);
+					NodesToVisit.Add(*ConnectedNode);
+				}
+			}
+		}
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value && !ReachedNodes.Contains(Node.Key))
+		{
+			OutNodeGuids.Add(Node.Key);
+		}
+	}
+}
+
+void UFlowAsset::StripUnreachableNodes()
+{
+	// package might be saved again before PostSaveRoot
+	if (CookStrippedNodes.Num() > 0)
+	{
+		return;
+	}
+
+	TArray<FGuid> UnreachableNodes;
+	GetUnreachableNodes(UnreachableNodes);
+
+	for (const FGuid& NodeGuid : UnreachableNodes)
+	{
+		UFlowNode* Node = Nodes.FindAndRemoveChecked(NodeGuid);
+
+		// node is still referenced by editor-only graph, transient flag prevents exporting it to the cooked package
+		Node->SetFlags(RF_Transient);
+		CookStrippedNodes.Add(NodeGuid, Node);
+	}
+}
+
+void UFlowAsset::RestoreStrippedNodes()
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : CookStrippedNodes)
+	{
+		Node.Value->ClearFlags(RF_Transient);
+		Nodes.Add(Node.Key, Node.Value);
+	}
+
+	CookStrippedNodes.Empty();
+}
+
+void UFlowAsset::StripNodeConnections()
+{
+	// package might be saved again before PostSaveRoot
+	if (bNodeConnectionsStripped)
+	{
+		return;
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		CookStrippedConnections.Add(Node.Key, MoveTemp(Node.Value->Connections));
+		CookStrippedFanOutConnections.Add(Node.Key, MoveTemp(Node.Value->FanOutConnections));
+	}
+
+	bNodeConnectionsStripped = true;
+}
+
+void UFlowAsset::RestoreNodeConnections()
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (TMap<FName, FConnectedPin>* Connections = CookStrippedConnections.Find(Node.Key))
+		{
+			Node.Value->Connections = MoveTemp(*Connections);
+		}
+
+		if (TMap<FName, FConnectedPins>* FanOutConnections = CookStrippedFanOutConnections.Find(Node.Key))
+		{
+			Node.Value->FanOutConnections = MoveTemp(*FanOutConnections);
+		}
+	}
+
+	CookStrippedConnections.Empty();
+	CookStrippedFanOutConnections.Empty();
+	bNodeConnectionsStripped = false;
+}
+
+bool UFlowAsset::CanInlineSubGraph(const UFlowAsset& SubGraphAsset, const int32 MaxNodes) const
+{
+	// inlined nodes might cast their Flow Asset to the class of the Sub Graph asset
+	if (&SubGraphAsset == this || !GetClass()->IsChildOf(SubGraphAsset.GetClass()))
+	{
+		return false;
+	}
+
+	if (SubGraphAsset.Nodes.Num() > MaxNodes || SubGraphAsset.GetDefaultEntryNode() == nullptr)
+	{
+		return false;
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Node : SubGraphAsset.Nodes)
+	{
+		// nested Sub Graphs keep creating instances, this also prevents recursion
+		if (Node.Value == nullptr || Node.Value->IsA<UFlowNode_SubGraph>())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UFlowAsset::InlineSubGraphs()
+{
+	const int32 MaxNodes = UFlowSettings::Get()->MaxInlinedSubGraphNodes;
+
+	// package might be saved again before PostSaveRoot
+	if (MaxNodes <= 0 || CookInlinedSubGraphs.Num() > 0)
+	{
+		return;
+	}
+
+	TArray<UFlowNode_SubGraph*> SubGraphNodes;
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node.Value))
+		{
+			SubGraphNodes.Add(SubGraphNode);
+		}
+	}
+
+	for (UFlowNode_SubGraph* SubGraphNode : SubGraphNodes)
+	{
+		const UFlowAsset* SubGraphAsset = SubGraphNode->Asset.IsNull() ? nullptr : SubGraphNode->Asset.LoadSynchronous();
+		if (SubGraphAsset == nullptr || !CanInlineSubGraph(*SubGraphAsset, MaxNodes))
+		{
+			continue;
+		}
+
+		TArray<FGuid> UnreachableNodes;
+		if (UFlowSettings::Get()->bStripUnreachableNodesOnCook)
+		{
+			SubGraphAsset->GetUnreachableNodes(UnreachableNodes);
+		}
+
+		// the same Sub Graph asset can be inlined by many Sub Graph nodes, so guids are combined with the Sub Graph node guid
+		const FGuid& SubGraphNodeGuid = SubGraphNode->GetGuid();
+		for (const TPair<FGuid, UFlowNode*>& SourceNode : SubGraphAsset->Nodes)
+		{
+			if (UnreachableNodes.Contains(SourceNode.Key))
+			{
+				continue;
+			}
+
+			const FName NodeName = MakeUniqueObjectName(this, SourceNode.Value->GetClass(), SourceNode.Value->GetFName());
+			UFlowNode* InlinedNode = DuplicateObject<UFlowNode>(SourceNode.Value, this, NodeName);
+			InlinedNode->GraphNode = nullptr;
+			InlinedNode->SetGuid(FGuid::Combine(SubGraphNodeGuid, SourceNode.Key));
+
+			for (TPair<FName, FConnectedPin>& Connection : InlinedNode->Connections)
+			{
+				Connection.Value.NodeGuid = FGuid::Combine(SubGraphNodeGuid, Connection.Value.NodeGuid);
+			}
+			for (TPair<FName, FConnectedPins>& FanOutConnection : InlinedNode->FanOutConnections)
+			{
+				for (FConnectedPin& Connection : FanOutConnection.Value.Pins)
+				{
+					Connection.NodeGuid = FGuid::Combine(SubGraphNodeGuid, Connection.NodeGuid);
+				}
+			}
+
+			Nodes.Add(InlinedNode->GetGuid(), InlinedNode);
+			InlinedNodes.Add(InlinedNode->GetGuid(), FFlowInlinedNode(SubGraphNodeGuid, SourceNode.Key));
+		}
+
+		SubGraphNode->InlinedEntryNodeGuid = FGuid::Combine(SubGraphNodeGuid, SubGraphAsset->GetDefaultEntryNode()->GetGuid());
+		CookInlinedSubGraphs.Add(SubGraphNode);
+	}
+}
+
+void UFlowAsset::RestoreInlinedSubGraphs()
+{
+	for (const TPair<FGuid, FFlowInlinedNode>& InlinedNode : InlinedNodes)
+	{
+		if (UFlowNode* Node = Nodes.FindRef(InlinedNode.Key))
+		{
+			Nodes.Remove(InlinedNode.Key);
+			Node->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+			Node->MarkAsGarbage();
+		}
+	}
+	InlinedNodes.Empty();
+
+	for (UFlowNode_SubGraph* SubGraphNode : CookInlinedSubGraphs)
+	{
+		SubGraphNode->InlinedEntryNodeGuid.Invalidate();
+	}
+	CookInlinedSubGraphs.Empty();
+}
+
 EDataValidationResult UFlowAsset::ValidateAsset(FFlowMessageLog& MessageLog)
 {
 	// validate nodes
@@ -136,7 +465,23 @@ EDataValidationResult UFlowAsset::ValidateAsset(FFlowMessageLog& MessageLog)
 		}
 	}
 
-	return MessageLog.Messages.Num() > 0 ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	const EDataValidationResult Result = MessageLog.Messages.Num() > 0 ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+
+	// unreachable nodes don't break the graph, so these are reported without invalidating the asset
+	{
+		TArray<FGuid> UnreachableNodes;
+		GetUnreachableNodes(UnreachableNodes);
+
+		const FString& WarningFormat = UFlowSettings::Get()->bStripUnreachableNodesOnCook ? ValidationWarning_UnreachableNodeStripped : ValidationWarning_UnreachableNode;
+		for (const FGuid& NodeGuid : UnreachableNodes)
+		{
+			UFlowNode* Node = Nodes.FindChecked(NodeGuid);
+			const FString WarningMsg = FString::Format(*WarningFormat, {*Node->GetNodeTitle().ToString()});
+			MessageLog.Warning(*WarningMsg, Node);
+		}
+	}
+
+	return Result;
 }
 
 bool UFlowAsset::IsNodeClassAllowed(const UClass* FlowNodeClass, FText* OutOptionalFailureReason) const
@@ -306,15 +651,27 @@ void UFlowAsset::HarvestNodeConnections()
 	{
 		UFlowNode* Node = Pair.Value;
 		TMap<FName, FConnectedPin> FoundConnections;
+		TMap<FName, FConnectedPins> FoundFanOutConnections;
 
 		for (const UEdGraphPin* ThisPin : Node->GetGraphNode()->Pins)
 		{
-			if (ThisPin->Direction == EGPD_Output && ThisPin->LinkedTo.Num() > 0)
+			if (ThisPin->Direction == EGPD_Output)
 			{
-				if (const UEdGraphPin* LinkedPin = ThisPin->LinkedTo[0])
+				// order of links decides the order of passing the signal
+				for (const UEdGraphPin* LinkedPin : ThisPin->LinkedTo)
 				{
-					const UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
-					FoundConnections.Add(ThisPin->PinName, FConnectedPin(LinkedNode->NodeGuid, LinkedPin->PinName));
+					if (LinkedPin)
+					{
+						const FConnectedPin Connection(LinkedPin->GetOwningNode()->NodeGuid, LinkedPin->PinName);
+						if (FoundConnections.Contains(ThisPin->PinName))
+						{
+							FoundFanOutConnections.FindOrAdd(ThisPin->PinName).Pins.Add(Connection);
+						}
+						else
+						{
+							FoundConnections.Add(ThisPin->PinName, Connection);
+						}
+					}
 				}
 			}
 		}
@@ -323,7 +680,7 @@ void UFlowAsset::HarvestNodeConnections()
 		// Optimization: we need check it only until the first node would be marked dirty, as this already marks Flow Asset package dirty
 		if (bGraphDirty == false)
 		{
-			if (FoundConnections.Num() != Node->Connections.Num())
+			if (FoundConnections.Num() != Node->Connections.Num() || !FoundFanOutConnections.OrderIndependentCompareEqual(Node->FanOutConnections))
 			{
 				bGraphDirty = true;
 			}
@@ -354,19 +711,122 @@ void UFlowAsset::HarvestNodeConnections()
 			Node->Modify();
 
 			Node->SetConnections(FoundConnections);
+			Node->SetFanOutConnections(FoundFanOutConnections);
 			Node->PostEditChange();
 		}
 	}
 }
 #endif
 
+void UFlowAsset::CompileGraph()
+{
+	// graph was compiled before stripping connections of cooked nodes
+	if (bNodeConnectionsStripped)
+	{
+		return;
+	}
+
+	CompiledGraph.Reset();
+
+	TMap<FGuid, int32> NodeIndexes;
+	NodeIndexes.Reserve(Nodes.Num());
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value)
+		{
+			NodeIndexes.Add(Node.Key, CompiledGraph.Nodes.Emplace(Node.Key));
+		}
+	}
+
+	for (FFlowCompiledNode& CompiledNode : CompiledGraph.Nodes)
+	{
+		const UFlowNode* Node = Nodes.FindChecked(CompiledNode.NodeGuid);
+		CompiledNode.FirstEdge = CompiledGraph.Edges.Num();
+
+		// same rule as UFlowNode::TriggerOutput, only connections of existing output pins are followed
+		for (const FFlowPin& OutputPin : Node->OutputPins)
+		{
+			TArray<FConnectedPin> Connections;
+			Node->GetConnections(OutputPin.PinName, Connections);
+
+			for (const FConnectedPin& Connection : Connections)
+			{
+				if (const int32* TargetNode = NodeIndexes.Find(Connection.NodeGuid))
+				{
+					CompiledGraph.Edges.Emplace(OutputPin.PinName, *TargetNode, Connection.PinName);
+				}
+			}
+		}
+
+		CompiledNode.NumEdges = CompiledGraph.Edges.Num() - CompiledNode.FirstEdge;
+	}
+
+	CollapsePassThroughNodes();
+
+	CompiledGraph.Version = FFlowCompiledGraph::LatestVersion;
+}
+
+void UFlowAsset::CollapsePassThroughNodes()
+{
+	const int32 NumNodes = CompiledGraph.Nodes.Num();
+
+	TBitArray<> PassThroughNodes(false, NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		const UFlowNode* Node = Nodes.FindChecked(CompiledGraph.Nodes[NodeIndex].NodeGuid);
+		PassThroughNodes[NodeIndex] = Node->SignalMode == EFlowSignalMode::Enabled && Node->IsPurePassThrough()
+			&& (Node->OutputPins.Num() == 0 || CompiledGraph.FindEdges(NodeIndex, Node->OutputPins[0].PinName).Num() <= 1);
+	}
+
+	// follows the chain of pass-through nodes, returns false if chain is a loop
+	auto ResolveTarget = [&](int32& InOutNode, FName& InOutPinName)
+	{
+		for (int32 Step = 0; InOutNode != INDEX_NONE && PassThroughNodes[InOutNode]; Step++)
+		{
+			if (Step == NumNodes)
+			{
+				return false;
+			}
+
+			const UFlowNode* PassThroughNode = Nodes.FindChecked(CompiledGraph.Nodes[InOutNode].NodeGuid);
+			const FFlowCompiledEdge* NextEdge = PassThroughNode->OutputPins.Num() > 0 ? CompiledGraph.FindEdge(InOutNode, PassThroughNode->OutputPins[0].PinName) : nullptr;
+
+			InOutNode = NextEdge ? NextEdge->TargetNode : INDEX_NONE;
+			InOutPinName = NextEdge ? NextEdge->TargetPinName : NAME_None;
+		}
+
+		return true;
+	};
+
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		int32 TargetNode = NodeIndex;
+		FName TargetPinName = NAME_None;
+		CompiledGraph.Nodes[NodeIndex].bCollapsible = PassThroughNodes[NodeIndex] && ResolveTarget(TargetNode, TargetPinName);
+	}
+
+	for (FFlowCompiledEdge& Edge : CompiledGraph.Edges)
+	{
+		int32 TargetNode = Edge.TargetNode;
+		FName TargetPinName = Edge.TargetPinName;
+
+		// signal entering the loop of pass-through nodes keeps going through node instances
+		if (ResolveTarget(TargetNode, TargetPinName))
+		{
+			Edge.CollapsedTargetNode = TargetNode;
+			Edge.CollapsedTargetPinName = TargetPinName;
+		}
+	}
+}
+
 UFlowNode* UFlowAsset::GetDefaultEntryNode() const
 {
 	UFlowNode* FirstStartNode = nullptr;
 
 	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
 	{
-		if (UFlowNode_Start* StartNode = Cast<UFlowNode_Start>(Node.Value))
+		UFlowNode_Start* StartNode = Cast<UFlowNode_Start>(Node.Value);
+		if (StartNode && !IsInlinedNode(StartNode))
 		{
 			if (StartNode->GetConnectedNodes().Num() > 0)
 			{
@@ -434,7 +894,8 @@ UFlowNode_CustomOutput* UFlowAsset::TryFindCustomOutputNodeByEventName(const FNa
 {
 	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
 	{
-		if (UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value))
+		UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value);
+		if (CustomOutput && !IsInlinedNode(CustomOutput))
 		{
 			if (CustomOutput->GetEventName() == EventName)
 			{
@@ -454,7 +915,8 @@ TArray<FName> UFlowAsset::GatherCustomInputNodeEventNames() const
 
 	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
 	{
-		if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value))
+		UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node.Value);
+		if (CustomInput && !IsInlinedNode(CustomInput))
 		{
 			Results.Add(CustomInput->GetEventName());
 		}
@@ -471,7 +933,8 @@ TArray<FName> UFlowAsset::GatherCustomOutputNodeEventNames() const
 
 	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
 	{
-		if (UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value))
+		UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Node.Value);
+		if (CustomOutput && !IsInlinedNode(CustomOutput))
 		{
 			Results.Add(CustomOutput->GetEventName());
 		}
@@ -498,6 +961,12 @@ TArray<UFlowNode*> UFlowAsset::GetNodesInExecutionOrder(UFlowNode* FirstIterated
 	return FoundNodes;
 }
 
+bool UFlowAsset::CanBeClusterRoot() const
+{
+	// editor modifies templates, instances hold runtime references to gameplay objects
+	return !GIsEditor && TemplateAsset == nullptr && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
 void UFlowAsset::AddInstance(UFlowAsset* Instance)
 {
 	ActiveInstances.Add(Instance);
@@ -512,7 +981,11 @@ int32 UFlowAsset::RemoveInstance(UFlowAsset* Instance)
 	}
 #endif
 
-	ActiveInstances.Remove(Instance);
+	// stale entries are dropped as well, so the returned number counts only existing instances
+	ActiveInstances.RemoveAll([Instance](const TWeakObjectPtr<UFlowAsset>& ActiveInstance)
+	{
+		return !ActiveInstance.IsValid() || ActiveInstance.Get() == Instance;
+	});
 	return ActiveInstances.Num();
 }
 
@@ -527,7 +1000,7 @@ void UFlowAsset::ClearInstances()
 
 	for (int32 i = ActiveInstances.Num() - 1; i >= 0; i--)
 	{
-		if (ActiveInstances.IsValidIndex(i) && ActiveInstances[i])
+		if (ActiveInstances.IsValidIndex(i) && ActiveInstances[i].IsValid())
 		{
 			ActiveInstances[i]->FinishFlow(EFlowFinishPolicy::Keep);
 		}
@@ -539,9 +1012,12 @@ void UFlowAsset::ClearInstances()
 #if WITH_EDITOR
 void UFlowAsset::GetInstanceDisplayNames(TArray<TSharedPtr<FName>>& OutDisplayNames) const
 {
-	for (const UFlowAsset* Instance : ActiveInstances)
+	for (const TWeakObjectPtr<UFlowAsset>& Instance : ActiveInstances)
 	{
-		OutDisplayNames.Emplace(MakeShareable(new FName(Instance->GetDisplayName())));
+		if (Instance.IsValid())
+		{
+			OutDisplayNames.Emplace(MakeShareable(new FName(Instance->GetDisplayName())));
+		}
 	}
 }
 
@@ -553,9 +1029,9 @@ void UFlowAsset::SetInspectedInstance(const FName& NewInspectedInstanceName)
 	}
 	else
 	{
-		for (UFlowAsset* ActiveInstance : ActiveInstances)
+		for (const TWeakObjectPtr<UFlowAsset>& ActiveInstance : ActiveInstances)
 		{
-			if (ActiveInstance && ActiveInstance->GetDisplayName() == NewInspectedInstanceName)
+			if (ActiveInstance.IsValid() && ActiveInstance->GetDisplayName() == NewInspectedInstanceName)
 			{
 				if (!InspectedInstance.IsValid() || InspectedInstance != ActiveInstance)
 				{
@@ -585,21 +1061,117 @@ void UFlowAsset::InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlow
 	Owner = InOwner;
 	TemplateAsset = InTemplateAsset;
 
-	for (TPair<FGuid, UFlowNode*>& Node : Nodes)
+	// nodes might ask for the owner while initializing
+	CacheOwnerContext();
+
+	// assets saved before introducing the compiled graph are compiled on the first use
+	if (!TemplateAsset->CompiledGraph.IsCompiled())
 	{
+		TemplateAsset->CompileGraph();
+	}
+
+	// collapsed nodes are never reached by signals
+	TSet<FGuid> CollapsedNodes;
+	if (UFlowSettings::Get()->ShouldCollapsePassThroughNodes())
+	{
+		for (const FFlowCompiledNode& CompiledNode : GetCompiledGraph().Nodes)
+		{
+			if (CompiledNode.bCollapsible)
+			{
+				CollapsedNodes.Add(CompiledNode.NodeGuid);
+			}
+		}
+	}
+
+	// lightweight nodes are removed from the instance, they're executed on the template node
+	TMap<FGuid, const UFlowNode*> LightweightTemplates;
+
+	for (auto NodeIt = Nodes.CreateIterator(); NodeIt; ++NodeIt)
+	{
+		TPair<FGuid, UFlowNode*>& Node = *NodeIt;
+		if (CollapsedNodes.Contains(Node.Key))
+		{
+			NodeIt.RemoveCurrent();
+			continue;
+		}
+
+		if (CanExecuteLightweight(*Node.Value))
+		{
+			LightweightTemplates.Add(Node.Key, Node.Value);
+			NodeIt.RemoveCurrent();
+			continue;
+		}
+
 		UFlowNode* NewNodeInstance = NewObject<UFlowNode>(this, Node.Value->GetClass(), NAME_None, RF_Transient, Node.Value, false, nullptr);
 		Node.Value = NewNodeInstance;
 
 		if (UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(NewNodeInstance))
 		{
-			if (!CustomInput->EventName.IsNone())
+			if (!CustomInput->EventName.IsNone() && !IsInlinedNode(CustomInput))
 			{
 				CustomInputNodes.Emplace(CustomInput);
 			}
 		}
 
+		NewNodeInstance->CacheImplementedBlueprintEvents();
 		NewNodeInstance->InitializeInstance();
 	}
+
+	const TArray<FFlowCompiledNode>& CompiledGraphNodes = GetCompiledGraph().Nodes;
+	CompiledNodes.SetNumZeroed(CompiledGraphNodes.Num());
+	for (int32 Index = 0; Index < CompiledGraphNodes.Num(); Index++)
+	{
+		if (UFlowNode* NodeInstance = Nodes.FindRef(CompiledGraphNodes[Index].NodeGuid))
+		{
+			NodeInstance->CompiledIndex = Index;
+			CompiledNodes[Index] = NodeInstance;
+		}
+		else if (const UFlowNode* LightweightTemplate = LightweightTemplates.FindRef(CompiledGraphNodes[Index].NodeGuid))
+		{
+			if (LightweightNodes.Num() == 0)
+			{
+				LightweightNodes.SetNum(CompiledGraphNodes.Num());
+			}
+
+			FLightweightNode& LightweightNode = LightweightNodes[Index];
+			LightweightNode.Template = LightweightTemplate;
+			LightweightNode.StateOffset = LightweightNodeStates.Num();
+			LightweightNode.StateSize = LightweightTemplate->GetLightweightStateSize();
+			LightweightNodeStates.AddZeroed(LightweightNode.StateSize);
+		}
+	}
+
+	InitializeLightweightNodeStates();
+}
+
+bool UFlowAsset::CanExecuteLightweight(const UFlowNode& Node) const
+{
+	// editor keeps node instances by default, so debugger can display their state
+	if (!UFlowSettings::Get()->ShouldExecuteLightweightRouteNodes())
+	{
+		return false;
+	}
+
+	// lightweight execution doesn't support alternative signal modes
+	return Node.SignalMode == EFlowSignalMode::Enabled && Node.GetLightweightStateSize() != INDEX_NONE;
+}
+
+void UFlowAsset::InitializeLightweightNodeStates()
+{
+	for (const FLightweightNode& LightweightNode : LightweightNodes)
+	{
+		if (LightweightNode.Template)
+		{
+			InitializeLightweightNodeState(LightweightNode);
+		}
+	}
+}
+
+void UFlowAsset::InitializeLightweightNodeState(const FLightweightNode& LightweightNode)
+{
+	const TArrayView<int32> State = TArrayView<int32>(LightweightNodeStates).Slice(LightweightNode.StateOffset, LightweightNode.StateSize);
+	FMemory::Memzero(State.GetData(), State.Num() * sizeof(int32));
+	LightweightNode.Template->InitializeLightweightState(State);
 }
 
 void UFlowAsset::DeinitializeInstance()
@@ -612,7 +1184,10 @@ void UFlowAsset::DeinitializeInstance()
 		}
 	}
 
-	if (TemplateAsset)
+	InvalidateOwnerContext();
+
+	// subsystem removes all instances at once
+	if (TemplateAsset && !(GetFlowSubsystem() && GetFlowSubsystem()->IsBulkTeardown()))
 	{
 		const int32 ActiveInstancesLeft = TemplateAsset->RemoveInstance(this);
 		if (ActiveInstancesLeft == 0 && GetFlowSubsystem())
@@ -622,8 +1197,60 @@ void UFlowAsset::DeinitializeInstance()
 	}
 }
 
+void UFlowAsset::InitializePooledInstance(const TWeakObjectPtr<UObject> InOwner)
+{
+	Owner = InOwner;
+	CacheOwnerContext();
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		Node.Value->InitializeInstance();
+	}
+}
+
+void UFlowAsset::ResetPooledInstance()
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (const UFlowNode* TemplateNode = TemplateAsset->Nodes.FindRef(Node.Key))
+		{
+			CopySaveGameProperties(Node.Value, TemplateNode);
+		}
+	}
+	ResetNodes();
+
+	// template doesn't hold states of lightweight nodes
+	const int32 NumLightweightStates = LightweightNodeStates.Num();
+	CopySaveGameProperties(this, TemplateAsset);
+	LightweightNodeStates.SetNumZeroed(NumLightweightStates);
+	InitializeLightweightNodeStates();
+
+	ActiveSubGraphs.Empty();
+	NodeOwningThisAssetInstance = nullptr;
+	FinishPolicy = EFlowFinishPolicy::Keep;
+
+	// parked instance has no owner, the new one is set while acquiring it from the pool
+	Owner.Reset();
+}
+
+void UFlowAsset::CopySaveGameProperties(UObject* Instance, const UObject* Template)
+{
+	for (TFieldIterator<FProperty> PropertyIt(Instance->GetClass()); PropertyIt; ++PropertyIt)
+	{
+		if (PropertyIt->HasAnyPropertyFlags(CPF_SaveGame))
+		{
+			PropertyIt->CopyCompleteValue_InContainer(Instance, Template);
+		}
+	}
+}
+
 void UFlowAsset::PreStartFlow()
 {
+	if (!bOwnerContextCached)
+	{
+		CacheOwnerContext();
+	}
+
 	ResetNodes();
 
 #if WITH_EDITOR
@@ -656,11 +1283,14 @@ void UFlowAsset::FinishFlow(const EFlowFinishPolicy InFinishPolicy, const bool b
 	FinishPolicy = InFinishPolicy;
 
 	// end execution of this asset and all of its nodes
-	for (UFlowNode* Node : ActiveNodes)
+	// array is moved away first, as deactivating inlined Sub Graph node would remove its nodes from the array
+	const TArray<UFlowNode*> NodesToDeactivate = MoveTemp(ActiveNodes);
+	ActiveNodes.Empty();
+
+	for (UFlowNode* Node : NodesToDeactivate)
 	{
 		Node->Deactivate();
 	}
-	ActiveNodes.Empty();
 
 	// flush preloaded content
 	for (UFlowNode* PreloadedNode : PreloadedNodes)
@@ -692,6 +1322,30 @@ AActor* UFlowAsset::TryFindActorOwner() const
 	return nullptr;
 }
 
+void UFlowAsset::CacheOwnerContext()
+{
+	if (TemplateAsset == nullptr)
+	{
+		return;
+	}
+
+	UObject* RootFlowOwner = Owner.Get();
+	CachedActorOwner = UFlowNode::TryGetActorOwner(RootFlowOwner);
+	CachedFlowOwnerInterface = UFlowNode::TryGetFlowOwnerInterface(RootFlowOwner, ExpectedOwnerClass);
+	CachedWorld = GetFlowSubsystem() ? GetFlowSubsystem()->GetWorld() : nullptr;
+
+	bOwnerContextCached = true;
+}
+
+void UFlowAsset::InvalidateOwnerContext()
+{
+	CachedActorOwner.Reset();
+	CachedFlowOwnerInterface.Reset();
+	CachedWorld.Reset();
+
+	bOwnerContextCached = false;
+}
+
 TWeakObjectPtr<UFlowAsset> UFlowAsset::GetFlowInstance(UFlowNode_SubGraph* SubGraphNode) const
 {
 	return ActiveSubGraphs.FindRef(SubGraphNode);
@@ -733,18 +1387,160 @@ void UFlowAsset::TriggerCustomOutput(const FName& EventName)
 	}
 }
 
+UFlowNode_SubGraph* UFlowAsset::GetInlinedSubGraphNode(const UFlowNode* Node) const
+{
+	const FFlowInlinedNode* InlinedNode = InlinedNodes.Num() > 0 ? FindInlinedNode(Node->GetGuid()) : nullptr;
+	return InlinedNode ? Cast<UFlowNode_SubGraph>(Nodes.FindRef(InlinedNode->SubGraphNodeGuid)) : nullptr;
+}
+
+void UFlowAsset::TriggerInlinedSubGraph(UFlowNode_SubGraph* SubGraphNode, const FName& PinName)
+{
+	TArray<UFlowNode*> SubGraphNodes;
+	GetInlinedNodes(SubGraphNode, SubGraphNodes);
+
+	// same as StartFlow and TriggerCustomInput called on the Sub Graph instance
+	if (PinName == UFlowNode_SubGraph::StartPin.PinName)
+	{
+		if (UFlowNode* EntryNode = Nodes.FindRef(SubGraphNode->InlinedEntryNodeGuid))
+		{
+			RecordedNodes.Add(EntryNode);
+			EntryNode->TriggerFirstOutput(true);
+		}
+	}
+	else
+	{
+		for (UFlowNode* Node : SubGraphNodes)
+		{
+			UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(Node);
+			if (CustomInput && CustomInput->EventName == PinName)
+			{
+				RecordedNodes.Add(CustomInput);
+				CustomInput->ExecuteInput(PinName);
+			}
+		}
+	}
+}
+
+void UFlowAsset::TriggerInlinedCustomOutput(const UFlowNode_CustomOutput* Node, const FName& EventName) const
+{
+	// same as TriggerCustomOutput called on the Sub Graph instance
+	if (UFlowNode_SubGraph* SubGraphNode = GetInlinedSubGraphNode(Node))
+	{
+		SubGraphNode->TriggerOutput(EventName);
+	}
+}
+
+void UFlowAsset::FinishInlinedSubGraph(const UFlowNode_SubGraph* SubGraphNode)
+{
+	// same as finishing the Sub Graph instance, nodes of the Sub Graph can't stay active
+	TArray<UFlowNode*> SubGraphNodes;
+	GetInlinedNodes(SubGraphNode, SubGraphNodes);
+
+	for (UFlowNode* Node : SubGraphNodes)
+	{
+		if (ActiveNodes.Contains(Node))
+		{
+			ActiveNodes.Remove(Node);
+			Node->Deactivate();
+		}
+
+		// Sub Graph triggered again starts with fresh nodes, like the pooled Sub Graph instance
+		if (const UFlowNode* TemplateNode = TemplateAsset->Nodes.FindRef(Node->GetGuid()))
+		{
+			CopySaveGameProperties(Node, TemplateNode);
+		}
+
+		RecordedNodes.Remove(Node);
+		Node->ResetRecords();
+	}
+
+	// lightweight nodes have no instances, only their states are initialized again
+	const TArray<FFlowCompiledNode>& CompiledGraphNodes = GetCompiledGraph().Nodes;
+	for (int32 Index = 0; Index < LightweightNodes.Num(); Index++)
+	{
+		const FFlowInlinedNode* InlinedNode = LightweightNodes[Index].Template ? InlinedNodes.Find(CompiledGraphNodes[Index].NodeGuid) : nullptr;
+		if (InlinedNode && InlinedNode->SubGraphNodeGuid == SubGraphNode->GetGuid())
+		{
+			InitializeLightweightNodeState(LightweightNodes[Index]);
+		}
+	}
+}
+
+void UFlowAsset::GetInlinedNodes(const UFlowNode_SubGraph* SubGraphNode, TArray<UFlowNode*>& OutNodes) const
+{
+	for (const TPair<FGuid, FFlowInlinedNode>& InlinedNode : InlinedNodes)
+	{
+		if (InlinedNode.Value.SubGraphNodeGuid == SubGraphNode->GetGuid())
+		{
+			// collapsed and lightweight nodes have no instances
+			if (UFlowNode* Node = Nodes.FindRef(InlinedNode.Key))
+			{
+				OutNodes.Add(Node);
+			}
+		}
+	}
+}
+
 void UFlowAsset::TriggerInput(const FGuid& NodeGuid, const FName& PinName)
 {
 	if (UFlowNode* Node = Nodes.FindRef(NodeGuid))
 	{
-		if (!ActiveNodes.Contains(Node))
+		TriggerNodeInput(Node, PinName);
+	}
+}
+
+void UFlowAsset::TriggerInput(const int32 CompiledNodeIndex, const FName& PinName)
+{
+	if (CompiledNodes.IsValidIndex(CompiledNodeIndex) && CompiledNodes[CompiledNodeIndex])
+	{
+		TriggerNodeInput(CompiledNodes[CompiledNodeIndex], PinName);
+	}
+	else if (LightweightNodes.IsValidIndex(CompiledNodeIndex) && LightweightNodes[CompiledNodeIndex].Template)
+	{
+		const FLightweightNode& LightweightNode = LightweightNodes[CompiledNodeIndex];
+		const TArrayView<int32> State = TArrayView<int32>(LightweightNodeStates).Slice(LightweightNode.StateOffset, LightweightNode.StateSize);
+		LightweightNode.Template->ExecuteLightweight(FFlowLightweightNodeContext(*this, CompiledNodeIndex, State), PinName);
+	}
+}
+
+void UFlowAsset::TriggerCompiledOutput(const int32 CompiledNodeIndex, const FName& PinName, const TSet<FGuid>* ExcludedNodes /* = nullptr */)
+{
+	// copied, as the editor compiles template again while creating its instance, i.e. by Sub Graph node triggered here
+	TArray<FFlowCompiledEdge, TInlineAllocator<4>> Edges(GetCompiledGraph().FindEdges(CompiledNodeIndex, PinName));
+	const bool bCollapseNodes = UFlowSettings::Get()->ShouldCollapsePassThroughNodes();
+
+	// excluded nodes are identified by direct connections, same as returned by UFlowNode::GetConnections
+	if (ExcludedNodes)
+	{
+		const TArray<FFlowCompiledNode>& CompiledGraphNodes = GetCompiledGraph().Nodes;
+		Edges.RemoveAll([ExcludedNodes, &CompiledGraphNodes](const FFlowCompiledEdge& Edge)
 		{
-			ActiveNodes.Add(Node);
-			RecordedNodes.Add(Node);
+			return ExcludedNodes->Contains(CompiledGraphNodes[Edge.TargetNode].NodeGuid);
+		});
+	}
+
+	for (const FFlowCompiledEdge& Edge : Edges)
+	{
+		if (bCollapseNodes)
+		{
+			TriggerInput(Edge.CollapsedTargetNode, Edge.CollapsedTargetPinName);
 		}
+		else
+		{
+			TriggerInput(Edge.TargetNode, Edge.TargetPinName);
+		}
+	}
+}
 
-		Node->TriggerInput(PinName);
+void UFlowAsset::TriggerNodeInput(UFlowNode* Node, const FName& PinName)
+{
+	if (!ActiveNodes.Contains(Node))
+	{
+		ActiveNodes.Add(Node);
+		RecordedNodes.Add(Node);
 	}
+
+	Node->TriggerInput(PinName);
 }
 
 void UFlowAsset::FinishNode(UFlowNode* Node)
@@ -756,7 +1552,11 @@ void UFlowAsset::FinishNode(UFlowNode* Node)
 		// if graph reached Finish and this asset instance was created by SubGraph node
 		if (Node->CanFinishGraph())
 		{
-			if (NodeOwningThisAssetInstance.IsValid())
+			if (UFlowNode_SubGraph* InlinedSubGraphNode = GetInlinedSubGraphNode(Node))
+			{
+				InlinedSubGraphNode->TriggerFirstOutput(true);
+			}
+			else if (NodeOwningThisAssetInstance.IsValid())
 			{
 				NodeOwningThisAssetInstance.Get()->TriggerFirstOutput(true);
 			}
@@ -809,7 +1609,17 @@ FFlowAssetSaveData UFlowAsset::SaveInstance(TArray<FFlowAssetSaveData>& SavedFlo
 
 	// iterate nodes
 	TArray<UFlowNode*> NodesInExecutionOrder;
-	GetNodesInExecutionOrder<UFlowNode>(GetDefaultEntryNode(), NodesInExecutionOrder);
+	if (Nodes.Num() < GetCompiledGraph().Nodes.Num())
+	{
+		// collapsed and lightweight nodes have no instances, so connections between node instances would be broken
+		// state of lightweight nodes is stored with the asset record
+		const UFlowNode* EntryNode = GetDefaultEntryNode();
+		GetCompiledNodesInExecutionOrder(EntryNode ? EntryNode->CompiledIndex : INDEX_NONE, NodesInExecutionOrder);
+	}
+	else
+	{
+		GetNodesInExecutionOrder<UFlowNode>(GetDefaultEntryNode(), NodesInExecutionOrder);
+	}
 	for (UFlowNode* Node : NodesInExecutionOrder)
 	{
 		if (Node && Node->ActivationState == EFlowNodeState::Active)
@@ -829,6 +1639,24 @@ FFlowAssetSaveData UFlowAsset::SaveInstance(TArray<FFlowAssetSaveData>& SavedFlo
 			Node->SaveInstance(NodeRecord);
 
 			AssetRecord.NodeRecords.Emplace(NodeRecord);
+
+			// inlined nodes aren't connected to the Sub Graph node
+			if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Node); SubGraphNode && SubGraphNode->IsInlined())
+			{
+				TArray<UFlowNode*> InlinedSubGraphNodes;
+				GetInlinedNodes(SubGraphNode, InlinedSubGraphNodes);
+
+				for (UFlowNode* InlinedNode : InlinedSubGraphNodes)
+				{
+					if (InlinedNode->ActivationState == EFlowNodeState::Active)
+					{
+						FFlowNodeSaveData InlinedNodeRecord;
+						InlinedNode->SaveInstance(InlinedNodeRecord);
+
+						AssetRecord.NodeRecords.Emplace(InlinedNodeRecord);
+					}
+				}
+			}
 		}
 	}
 
@@ -845,10 +1673,21 @@ FFlowAssetSaveData UFlowAsset::SaveInstance(TArray<FFlowAssetSaveData>& SavedFlo
 
 void UFlowAsset::LoadInstance(const FFlowAssetSaveData& AssetRecord)
 {
+	const int32 LightweightStatesNum = LightweightNodeStates.Num();
+
 	FMemoryReader MemoryReader(AssetRecord.AssetData, true);
 	FFlowArchive Ar(MemoryReader);
 	Serialize(Ar);
 
+	// SaveGame was written with different graph or lightweight nodes setting
+	if (LightweightNodeStates.Num() != LightweightStatesNum)
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Lightweight node states of %s don't match the SaveGame, resetting them."), *GetName());
+
+		LightweightNodeStates.SetNumZeroed(LightweightStatesNum);
+		InitializeLightweightNodeStates();
+	}
+
 	PreStartFlow();
 
 	// iterate graph "from the end", backward to execution order
@@ -864,6 +1703,59 @@ void UFlowAsset::LoadInstance(const FFlowAssetSaveData& AssetRecord)
 	OnLoad();
 }
 
+bool UFlowAsset::CanHibernate(FFlowWakeUpConditions& OutConditions) const
+{
+	// Sub Graph instances and preloaded content would need to be restored separately
+	if (ActiveNodes.Num() == 0 || ActiveSubGraphs.Num() > 0 || PreloadedNodes.Num() > 0)
+	{
+		return false;
+	}
+
+	for (const UFlowNode* Node : ActiveNodes)
+	{
+		if (!Node->CanHibernate(OutConditions))
+		{
+			return false;
+		}
+	}
+
+	return OutConditions.IsValid();
+}
+
+void UFlowAsset::GetCompiledNodesInExecutionOrder(const int32 FirstNodeIndex, TArray<UFlowNode*>& OutNodes) const
+{
+	const FFlowCompiledGraph& Graph = GetCompiledGraph();
+	if (!Graph.Nodes.IsValidIndex(FirstNodeIndex))
+	{
+		return;
+	}
+
+	TBitArray<> IteratedNodes(false, Graph.Nodes.Num());
+	TArray<int32> NodesToIterate = {FirstNodeIndex};
+	IteratedNodes[FirstNodeIndex] = true;
+
+	while (NodesToIterate.Num() > 0)
+	{
+		const int32 NodeIndex = NodesToIterate.Pop();
+		if (CompiledNodes.IsValidIndex(NodeIndex) && CompiledNodes[NodeIndex])
+		{
+			OutNodes.Emplace(CompiledNodes[NodeIndex]);
+		}
+
+		// push in reverse, so the first connection is iterated first
+		const FFlowCompiledNode& Node = Graph.Nodes[NodeIndex];
+		for (int32 EdgeIndex = Node.FirstEdge + Node.NumEdges - 1; EdgeIndex >= Node.FirstEdge; EdgeIndex--)
+		{
+			const int32 TargetNode = Graph.Edges[EdgeIndex].TargetNode;
+			if (!IteratedNodes[TargetNode])
+			{
+				IteratedNodes[TargetNode] = true;
+				NodesToIterate.Push(TargetNode);
+			}
+		}
+	}
+}
+
 void UFlowAsset::OnActivationStateLoaded(UFlowNode* Node)
 {
 	if (Node->ActivationState != EFlowNodeState::NeverActivated)
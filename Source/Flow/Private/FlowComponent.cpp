@@ -23,6 +23,7 @@ UFlowComponent::UFlowComponent(const FObjectInitializer& ObjectInitializer)
 	, bAutoStartRootFlow(true)
 	, RootFlowMode(EFlowNetMode::Authority)
 	, bAllowMultipleInstances(true)
+	, Significance(1.0f)
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
@@ -86,6 +87,14 @@ void UFlowComponent::UnregisterWithFlowSubsystem()
 {
 	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
+		// whole world is ending, so flows of all components are torn down at once
+		UWorld* World = GetWorld();
+		if (World && World->bIsTearingDown)
+		{
+			FlowSubsystem->TeardownWorldFlows(World);
+			return;
+		}
+
 		FlowSubsystem->FinishAllRootFlows(this, EFlowFinishPolicy::Keep);
 		FlowSubsystem->UnregisterComponent(this);
 	}
@@ -298,12 +307,32 @@ void UFlowComponent::BulkNotifyGraph(const FGameplayTagContainer NotifyTags, con
 
 void UFlowComponent::OnRep_SentNotifyTags()
 {
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+
 	for (const FGameplayTag& NotifyTag : RecentlySentNotifyTags)
 	{
-		OnNotifyFromComponent.Broadcast(this, NotifyTag);
+		if (FlowSubsystem && FlowSubsystem->IsOwnerThrottled(this))
+		{
+			FlowSubsystem->DeferNotify(this, NotifyTag);
+		}
+		else
+		{
+			BroadcastNotify(NotifyTag);
+		}
 	}
 }
 
+void UFlowComponent::BroadcastNotify(const FGameplayTag& NotifyTag)
+{
+	// restore hibernated Flow Graphs first, so their nodes receive this notify
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->WakeUpHibernatedFlows(this, NotifyTag);
+	}
+
+	OnNotifyFromComponent.Broadcast(this, NotifyTag);
+}
+
 void UFlowComponent::NotifyFromGraph(const FGameplayTagContainer& NotifyTags, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
 {
 	if (IsFlowNetMode(NetMode) && NotifyTags.IsValid() && HasBegunPlay())
@@ -387,6 +416,31 @@ void UFlowComponent::StartRootFlow()
 	}
 }
 
+void UFlowComponent::StartRootFlows(const TArray<UFlowComponent*>& Components)
+{
+	// components might belong to different game instances, i.e. while testing multiplayer in PIE
+	TMap<UFlowSubsystem*, TArray<FFlowRootFlowRequest>> RequestsPerSubsystem;
+
+	for (UFlowComponent* Component : Components)
+	{
+		if (Component && Component->RootFlow && Component->IsFlowNetMode(Component->RootFlowMode))
+		{
+			if (UFlowSubsystem* FlowSubsystem = Component->GetFlowSubsystem())
+			{
+				Component->VerifyIdentityTags();
+
+				RequestsPerSubsystem.FindOrAdd(FlowSubsystem).Emplace(Component, Component->RootFlow, Component->bAllowMultipleInstances);
+			}
+		}
+	}
+
+	for (const TPair<UFlowSubsystem*, TArray<FFlowRootFlowRequest>>& Requests : RequestsPerSubsystem)
+	{
+		TArray<UFlowAsset*> StartedInstances;
+		Requests.Key->StartRootFlows(Requests.Value, StartedInstances);
+	}
+}
+
 void UFlowComponent::FinishRootFlow(UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy)
 {
 	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
@@ -421,6 +475,25 @@ UFlowAsset* UFlowComponent::GetRootFlowInstance() const
 	return nullptr;
 }
 
+void UFlowComponent::SetSignificance(const float NewSignificance)
+{
+	const bool bWasThrottled = IsThrottled();
+	Significance = NewSignificance;
+
+	if (IsThrottled() != bWasThrottled)
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			FlowSubsystem->SetOwnerThrottled(this, !bWasThrottled);
+		}
+	}
+}
+
+bool UFlowComponent::IsThrottled() const
+{
+	return Significance < UFlowSettings::Get()->ThrottledSignificance;
+}
+
 void UFlowComponent::OnTriggerRootFlowOutputEventDispatcher(UFlowAsset* RootFlowInstance, const FName& EventName)
 {
 	BP_OnTriggerRootFlowOutputEvent(RootFlowInstance, EventName);
@@ -469,21 +542,15 @@ FFlowComponentSaveData UFlowComponent::SaveInstance()
 
 bool UFlowComponent::LoadInstance()
 {
-	const UFlowSaveGame* SaveGame = GetFlowSubsystem()->GetLoadedSaveGame();
-	if (SaveGame->FlowComponents.Num() > 0)
+	UFlowSaveGame* SaveGame = GetFlowSubsystem()->GetLoadedSaveGame();
+	if (const FFlowComponentSaveData* ComponentRecord = SaveGame->FindComponentRecord(GetWorld()->GetName(), GetOwner()->GetName()))
 	{
-		for (const FFlowComponentSaveData& ComponentRecord : SaveGame->FlowComponents)
-		{
-			if (ComponentRecord.WorldName == GetWorld()->GetName() && ComponentRecord.ActorInstanceName == GetOwner()->GetName())
-			{
-				FMemoryReader MemoryReader(ComponentRecord.ComponentData, true);
-				FFlowArchive Ar(MemoryReader);
-				Serialize(Ar);
+		FMemoryReader MemoryReader(ComponentRecord->ComponentData, true);
+		FFlowArchive Ar(MemoryReader);
+		Serialize(Ar);
 
-				OnLoad();
-				return true;
-			}
-		}
+		OnLoad();
+		return true;
 	}
 
 	return false;
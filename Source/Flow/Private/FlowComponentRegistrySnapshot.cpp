@@ -0,0 +1,137 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowComponentRegistrySnapshot.h"
+#include "FlowComponent.h"
+
+#include "GameFramework/Actor.h"
+
+FFlowComponentRegistrySnapshot::FFlowComponentRegistrySnapshot()
+	: FrameNumber(0)
+{
+}
+
+FFlowComponentRegistrySnapshot::FFlowComponentRegistrySnapshot(const TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>>& Registry, const uint64 InFrameNumber)
+	: FrameNumber(InFrameNumber)
+{
+	check(IsInGameThread());
+
+	for (const TPair<FGameplayTag, TWeakObjectPtr<UFlowComponent>>& Pair : Registry)
+	{
+		if (Pair.Value.IsValid())
+		{
+			EntriesByTag.FindOrAdd(Pair.Key).Add({Pair.Value, Pair.Value->GetOwner()});
+		}
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	TArray<const FEntry*> Entries;
+	FindEntries(Tag, bExactMatch, Entries);
+
+	OutComponents.Reserve(OutComponents.Num() + Entries.Num());
+	for (const FEntry* Entry : Entries)
+	{
+		OutComponents.Emplace(Entry->Component);
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	TArray<const FEntry*> Entries;
+	FindEntries(Tags, MatchType, bExactMatch, Entries);
+
+	for (const FEntry* Entry : Entries)
+	{
+		OutComponents.Emplace(Entry->Component);
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindActors(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<AActor>>& OutActors) const
+{
+	TArray<const FEntry*> Entries;
+	FindEntries(Tag, bExactMatch, Entries);
+
+	OutActors.Reserve(OutActors.Num() + Entries.Num());
+	for (const FEntry* Entry : Entries)
+	{
+		OutActors.Emplace(Entry->Actor);
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindActors(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<AActor>>& OutActors) const
+{
+	TArray<const FEntry*> Entries;
+	FindEntries(Tags, MatchType, bExactMatch, Entries);
+
+	for (const FEntry* Entry : Entries)
+	{
+		OutActors.Emplace(Entry->Actor);
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindEntries(const FGameplayTag& Tag, const bool bExactMatch, TArray<const FEntry*>& OutEntries) const
+{
+	if (bExactMatch)
+	{
+		if (const TArray<FEntry>* Entries = EntriesByTag.Find(Tag))
+		{
+			for (const FEntry& Entry : *Entries)
+			{
+				OutEntries.Add(&Entry);
+			}
+		}
+	}
+	else
+	{
+		for (const TPair<FGameplayTag, TArray<FEntry>>& Pair : EntriesByTag)
+		{
+			if (Pair.Key.MatchesTag(Tag))
+			{
+				for (const FEntry& Entry : Pair.Value)
+				{
+					OutEntries.Add(&Entry);
+				}
+			}
+		}
+	}
+}
+
+void FFlowComponentRegistrySnapshot::FindEntries(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TArray<const FEntry*>& OutEntries) const
+{
+	// components can't be accessed outside of the game thread, so matched tags are counted per component
+	TMap<TWeakObjectPtr<UFlowComponent>, TPair<const FEntry*, int32>> Matches;
+
+	int32 TagIndex = 0;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		TArray<const FEntry*> EntriesPerTag;
+		FindEntries(Tag, bExactMatch, EntriesPerTag);
+
+		for (const FEntry* Entry : EntriesPerTag)
+		{
+			TPair<const FEntry*, int32>* Match = Matches.Find(Entry->Component);
+			if (Match == nullptr)
+			{
+				Match = &Matches.Add(Entry->Component, TPair<const FEntry*, int32>(Entry, 0));
+			}
+
+			// component counts once per tag, even if it matched it by multiple child tags
+			if (Match->Value == TagIndex)
+			{
+				Match->Value++;
+			}
+		}
+
+		TagIndex++;
+	}
+
+	OutEntries.Reserve(OutEntries.Num() + Matches.Num());
+	for (const TPair<TWeakObjectPtr<UFlowComponent>, TPair<const FEntry*, int32>>& Match : Matches)
+	{
+		if (MatchType == EGameplayContainerMatchType::Any || Match.Value.Value == TagIndex)
+		{
+			OutEntries.Add(Match.Value.Key);
+		}
+	}
+}
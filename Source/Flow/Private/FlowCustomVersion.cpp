@@ -0,0 +1,9 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowCustomVersion.h"
+
+#include "Serialization/CustomVersion.h"
+
+const FGuid FFlowCustomVersion::GUID(0x671CB9A1, 0xC49842C1, 0xB9548BDF, 0x33C94FEC);
+
+FCustomVersionRegistration GRegisterFlowCustomVersion(FFlowCustomVersion::GUID, FFlowCustomVersion::LatestVersion, TEXT("FlowVer"));
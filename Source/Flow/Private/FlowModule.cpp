@@ -1,15 +1,37 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "FlowModule.h"
+#include "FlowOwnerFunctionRef.h"
+#include "Nodes/FlowNode.h"
 
 #include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
 
 void FFlowModule::StartupModule()
 {
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		ResetClassCaches();
+	});
+
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		ResetClassCaches();
+	});
 }
 
 void FFlowModule::ShutdownModule()
 {
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+
+	ResetClassCaches();
+}
+
+void FFlowModule::ResetClassCaches()
+{
+	FFlowOwnerFunctionCache::Reset();
+	UFlowNode::ResetImplementedBlueprintEvents();
 }
 
 IMPLEMENT_MODULE(FFlowModule, Flow)
@@ -0,0 +1,63 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowNotifyQueue.h"
+#include "FlowAsset.h"
+#include "FlowComponent.h"
+
+#include "HAL/PlatformTLS.h"
+
+FFlowNotifyQueue::FFlowNotifyQueue()
+	: bClosed(false)
+{
+}
+
+void FFlowNotifyQueue::QueueNotifyGraph(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode)
+{
+	FQueuedNotify Notify;
+	Notify.Type = FQueuedNotify::EType::Graph;
+	Notify.NetMode = NetMode;
+	Notify.Target = Component;
+	Notify.NotifyTag = NotifyTag;
+	Enqueue(MoveTemp(Notify));
+}
+
+void FFlowNotifyQueue::QueueNotifyActor(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode)
+{
+	FQueuedNotify Notify;
+	Notify.Type = FQueuedNotify::EType::Actor;
+	Notify.NetMode = NetMode;
+	Notify.Target = Component;
+	Notify.ActorTag = ActorTag;
+	Notify.NotifyTag = NotifyTag;
+	Enqueue(MoveTemp(Notify));
+}
+
+void FFlowNotifyQueue::QueueCustomInput(const TWeakObjectPtr<UFlowAsset>& FlowInstance, const FName& EventName)
+{
+	FQueuedNotify Notify;
+	Notify.Type = FQueuedNotify::EType::CustomInput;
+	Notify.Target = FlowInstance;
+	Notify.EventName = EventName;
+	Enqueue(MoveTemp(Notify));
+}
+
+void FFlowNotifyQueue::Enqueue(FQueuedNotify&& Notify)
+{
+	// notify racing with closing the queue is never sent, it's released with the queue
+	if (!bClosed.load())
+	{
+		Notify.ProducerId = FPlatformTLS::GetCurrentThreadId();
+		Notifies.Enqueue(MoveTemp(Notify));
+	}
+}
+
+bool FFlowNotifyQueue::Dequeue(FQueuedNotify& OutNotify)
+{
+	return Notifies.Dequeue(OutNotify);
+}
+
+void FFlowNotifyQueue::Close()
+{
+	bClosed = true;
+	Notifies.Empty();
+}
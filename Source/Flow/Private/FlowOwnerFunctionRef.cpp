@@ -8,11 +8,106 @@
 
 #include "Logging/LogMacros.h"
 #include "UObject/Class.h"
+#include "UObject/UObjectGlobals.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowOwnerFunctionRef)
 
+TMap<TPair<TObjectKey<UClass>, FName>, FFlowOwnerNativeFunction> FFlowOwnerNativeFunctionRegistry::NativeFunctions;
+
+void FFlowOwnerNativeFunctionRegistry::Register(const UClass* OwnerClass, const FName& FunctionName, FFlowOwnerNativeFunction NativeFunction)
+{
+	check(IsInGameThread());
+
+	if (OwnerClass && NativeFunction)
+	{
+		NativeFunctions.Add(TPair<TObjectKey<UClass>, FName>(OwnerClass, FunctionName), NativeFunction);
+
+		// functions might have been already resolved without the binding
+		FFlowOwnerFunctionCache::Reset();
+	}
+}
+
+void FFlowOwnerNativeFunctionRegistry::Unregister(const UClass* OwnerClass, const FName& FunctionName)
+{
+	check(IsInGameThread());
+
+	if (NativeFunctions.Remove(TPair<TObjectKey<UClass>, FName>(OwnerClass, FunctionName)) > 0)
+	{
+		FFlowOwnerFunctionCache::Reset();
+	}
+}
+
+FFlowOwnerNativeFunction FFlowOwnerNativeFunctionRegistry::Find(const UClass& OwnerClass, const FName& FunctionName)
+{
+	for (const UClass* Class = &OwnerClass; Class; Class = Class->GetSuperClass())
+	{
+		if (const FFlowOwnerNativeFunction* NativeFunction = NativeFunctions.Find(TPair<TObjectKey<UClass>, FName>(Class, FunctionName)))
+		{
+			return *NativeFunction;
+		}
+	}
+
+	return nullptr;
+}
+
+TMap<FFlowOwnerFunctionCache::FKey, FFlowOwnerFunctionCache::FEntry> FFlowOwnerFunctionCache::Entries;
+
+const FFlowOwnerFunctionCache::FEntry& FFlowOwnerFunctionCache::FindOrResolve(const UClass& OwnerClass, const FName& FunctionName, const UClass& ParamsClass)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = Entries.FindOrAdd(FKey(&OwnerClass, FunctionName, &ParamsClass));
+
+	// resolve new entry or the one pointing to function destroyed by recompiling the class
+	if (!Entry.bResolved || Entry.Function.IsStale())
+	{
+		UFunction* Function = OwnerClass.FindFunctionByName(FunctionName);
+
+		Entry.Function = Function;
+		Entry.bValidSignature = Function && IsSignatureCompatible(*Function, ParamsClass);
+		Entry.bResolved = true;
+
+		// function overridden in Blueprint isn't native anymore
+		Entry.NativeFunction = Entry.bValidSignature && Function->HasAnyFunctionFlags(FUNC_Native) ? FFlowOwnerNativeFunctionRegistry::Find(OwnerClass, FunctionName) : nullptr;
+	}
+
+	return Entry;
+}
+
+void FFlowOwnerFunctionCache::Reset()
+{
+	Entries.Empty();
+}
+
+bool FFlowOwnerFunctionCache::IsSignatureCompatible(const UFunction& Function, const UClass& ParamsClass)
+{
+	// See FFlowOwnerFunctionSignature: single params object and FName return value
+	if (Function.NumParms != 2)
+	{
+		return false;
+	}
+
+	const FNameProperty* ReturnProperty = CastField<FNameProperty>(Function.GetReturnProperty());
+	if (ReturnProperty == nullptr)
+	{
+		return false;
+	}
+
+	for (TFieldIterator<FProperty> Iterator(&Function); Iterator && (Iterator->PropertyFlags & CPF_Parm); ++Iterator)
+	{
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(*Iterator))
+		{
+			return IsValid(ObjectProperty->PropertyClass) && ParamsClass.IsChildOf(ObjectProperty->PropertyClass);
+		}
+	}
+
+	return false;
+}
+
 UFunction* FFlowOwnerFunctionRef::TryResolveFunction(const UClass& InClass)
 {
+	NativeFunction = nullptr;
+
 	if (IsConfigured())
 	{
 		Function = InClass.FindFunctionByName(FunctionName);
@@ -25,7 +120,30 @@ UFunction* FFlowOwnerFunctionRef::TryResolveFunction(const UClass& InClass)
 	return Function;
 }
 
+UFunction* FFlowOwnerFunctionRef::TryResolveFunction(const UClass& InClass, const UClass& InParamsClass)
+{
+	Function = nullptr;
+	NativeFunction = nullptr;
+
+	if (IsConfigured())
+	{
+		const FFlowOwnerFunctionCache::FEntry& Entry = FFlowOwnerFunctionCache::FindOrResolve(InClass, FunctionName, InParamsClass);
+		if (Entry.bValidSignature)
+		{
+			Function = Entry.Function.Get();
+			NativeFunction = Entry.NativeFunction;
+		}
+	}
+
+	return Function;
+}
+
 FName FFlowOwnerFunctionRef::CallFunction(IFlowOwnerInterface& InFlowOwnerInterface, UFlowOwnerFunctionParams& InParams) const
+{
+	return CallFunction(InFlowOwnerInterface, InParams, InParams.GatherOutputNames());
+}
+
+FName FFlowOwnerFunctionRef::CallFunction(IFlowOwnerInterface& InFlowOwnerInterface, UFlowOwnerFunctionParams& InParams, const TArray<FName>& InOutputNames) const
 {
 	if (!IsResolved())
 	{
@@ -55,17 +173,22 @@ FName FFlowOwnerFunctionRef::CallFunction(IFlowOwnerInterface& InFlowOwnerInterf
 	FFlowOwnerFunctionRef_Parms Parms = {&InParams, NAME_None};
 
 	// Call the owner function itself
-	FlowOwnerObject->ProcessEvent(Function, &Parms);
+	if (NativeFunction)
+	{
+		Parms.OutputPinName = NativeFunction(*FlowOwnerObject, InParams);
+	}
+	else
+	{
+		FlowOwnerObject->ProcessEvent(Function, &Parms);
+	}
 
 	// Ensure the return value is valid
 	if (!Parms.OutputPinName.IsNone())
 	{
-		const TArray<FName> OutputNames = InParams.GatherOutputNames();
-
-		if (!OutputNames.Contains(Parms.OutputPinName))
+		if (!InOutputNames.Contains(Parms.OutputPinName))
 		{
 			FString OutputNamesStr = TEXT("None");
-			for (const FName& OutputName : OutputNames)
+			for (const FName& OutputName : InOutputNames)
 			{
 				OutputNamesStr += TEXT(", ") + OutputName.ToString();
 			}
@@ -0,0 +1,326 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowSave.h"
+#include "FlowLogChannels.h"
+
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowSave)
+
+namespace FlowSave
+{
+	// bump if layout of records inside the compressed block changes
+	static constexpr int32 WorldBlockVersion = 1;
+}
+
+void UFlowSaveGame::BuildWorldIndexes() const
+{
+	WorldIndexes.Reset();
+
+	// first record wins in case of duplicated names, same as the linear search did
+	for (int32 Index = 0; Index < FlowComponents.Num(); Index++)
+	{
+		const FFlowComponentSaveData& ComponentRecord = FlowComponents[Index];
+		TMap<FString, int32>& Components = WorldIndexes.FindOrAdd(ComponentRecord.WorldName).ComponentsByActorName;
+		if (!Components.Contains(ComponentRecord.ActorInstanceName))
+		{
+			Components.Add(ComponentRecord.ActorInstanceName, Index);
+		}
+	}
+
+	for (int32 Index = 0; Index < FlowInstances.Num(); Index++)
+	{
+		const FFlowAssetSaveData& AssetRecord = FlowInstances[Index];
+		TMap<FString, int32>& Instances = WorldIndexes.FindOrAdd(AssetRecord.WorldName).InstancesByName;
+		if (!Instances.Contains(AssetRecord.InstanceName))
+		{
+			Instances.Add(AssetRecord.InstanceName, Index);
+		}
+	}
+
+	bWorldIndexesValid = true;
+}
+
+const FFlowComponentSaveData* UFlowSaveGame::FindComponentRecord(const FString& WorldName, const FString& ActorInstanceName)
+{
+	UnpackWorldBlocks(WorldName);
+
+	if (!bWorldIndexesValid)
+	{
+		BuildWorldIndexes();
+	}
+
+	if (const FFlowWorldSaveIndex* WorldIndex = WorldIndexes.Find(WorldName))
+	{
+		if (const int32* Index = WorldIndex->ComponentsByActorName.Find(ActorInstanceName))
+		{
+			// arrays modified without invalidating indexes
+			if (!FlowComponents.IsValidIndex(*Index) || FlowComponents[*Index].WorldName != WorldName || FlowComponents[*Index].ActorInstanceName != ActorInstanceName)
+			{
+				BuildWorldIndexes();
+				return FindComponentRecord(WorldName, ActorInstanceName);
+			}
+
+			return &FlowComponents[*Index];
+		}
+	}
+
+	return nullptr;
+}
+
+const FFlowAssetSaveData* UFlowSaveGame::FindInstanceRecord(const FString& WorldName, const FString& InstanceName)
+{
+	UnpackWorldBlocks(WorldName);
+
+	if (!bWorldIndexesValid)
+	{
+		BuildWorldIndexes();
+	}
+
+	if (const FFlowWorldSaveIndex* WorldIndex = WorldIndexes.Find(WorldName))
+	{
+		if (const int32* Index = WorldIndex->InstancesByName.Find(InstanceName))
+		{
+			// arrays modified without invalidating indexes
+			if (!FlowInstances.IsValidIndex(*Index) || FlowInstances[*Index].WorldName != WorldName || FlowInstances[*Index].InstanceName != InstanceName)
+			{
+				BuildWorldIndexes();
+				return FindInstanceRecord(WorldName, InstanceName);
+			}
+
+			return &FlowInstances[*Index];
+		}
+	}
+
+	return nullptr;
+}
+
+void UFlowSaveGame::RemoveWorldRecords(const FString& WorldName)
+{
+	FlowInstances.RemoveAll([&WorldName](const FFlowAssetSaveData& AssetRecord)
+	{
+		return AssetRecord.WorldName.IsEmpty() || AssetRecord.WorldName == WorldName;
+	});
+
+	FlowComponents.RemoveAll([&WorldName](const FFlowComponentSaveData& ComponentRecord)
+	{
+		return ComponentRecord.WorldName.IsEmpty() || ComponentRecord.WorldName == WorldName;
+	});
+
+	WorldBlocks.RemoveAll([&WorldName](const FFlowWorldSaveBlock& WorldBlock)
+	{
+		return WorldBlock.WorldName.IsEmpty() || WorldBlock.WorldName == WorldName;
+	});
+
+	InvalidateWorldIndexes();
+}
+
+void UFlowSaveGame::PackWorldBlocks(const FName CompressionFormat)
+{
+	FFlowSaveGameRecords Records;
+	SwapRecords(Records);
+	Records.PackWorldBlocks(CompressionFormat);
+	SwapRecords(Records);
+}
+
+void UFlowSaveGame::SwapRecords(FFlowSaveGameRecords& Records)
+{
+	Swap(FlowComponents, Records.FlowComponents);
+	Swap(FlowInstances, Records.FlowInstances);
+	Swap(WorldBlocks, Records.WorldBlocks);
+	InvalidateWorldIndexes();
+}
+
+void UFlowSaveGame::UnpackWorldBlocks(const FString& WorldName)
+{
+	// records not bound to any world are requested together with world records, i.e. while loading Sub Graphs
+	// unpacking both at once ensures records returned earlier won't be moved by the later request
+	if (WorldBlocks.Num() > 0)
+	{
+		UnpackWorldBlock(WorldName);
+		UnpackWorldBlock(FString());
+	}
+}
+
+bool UFlowSaveGame::UnpackWorldBlock(const FString& WorldName)
+{
+	// indexes stay valid, if there's nothing to unpack
+	if (!WorldBlocks.ContainsByPredicate([&WorldName](const FFlowWorldSaveBlock& WorldBlock) { return WorldBlock.WorldName == WorldName; }))
+	{
+		return false;
+	}
+
+	FFlowSaveGameRecords Records;
+	SwapRecords(Records);
+	const bool bSuccess = Records.UnpackWorldBlock(WorldName);
+	SwapRecords(Records);
+
+	return bSuccess;
+}
+
+void FFlowSaveGameRecords::PackWorldBlocks(const FName CompressionFormat)
+{
+	if (FlowComponents.Num() == 0 && FlowInstances.Num() == 0)
+	{
+		return;
+	}
+
+	struct FWorldRecords
+	{
+		TArray<FFlowComponentSaveData> Components;
+		TArray<FFlowAssetSaveData> Instances;
+	};
+
+	// merge with records of the same world compressed earlier
+	TSet<FString> WorldNames;
+	for (const FFlowComponentSaveData& ComponentRecord : FlowComponents)
+	{
+		WorldNames.Add(ComponentRecord.WorldName);
+	}
+	for (const FFlowAssetSaveData& AssetRecord : FlowInstances)
+	{
+		WorldNames.Add(AssetRecord.WorldName);
+	}
+	for (const FString& WorldName : WorldNames)
+	{
+		UnpackWorldBlock(WorldName);
+	}
+
+	TMap<FString, FWorldRecords> RecordsByWorld;
+	for (FFlowComponentSaveData& ComponentRecord : FlowComponents)
+	{
+		RecordsByWorld.FindOrAdd(ComponentRecord.WorldName).Components.Emplace(MoveTemp(ComponentRecord));
+	}
+	for (FFlowAssetSaveData& AssetRecord : FlowInstances)
+	{
+		RecordsByWorld.FindOrAdd(AssetRecord.WorldName).Instances.Emplace(MoveTemp(AssetRecord));
+	}
+
+	FlowComponents.Empty();
+	FlowInstances.Empty();
+
+	for (TPair<FString, FWorldRecords>& WorldRecords : RecordsByWorld)
+	{
+		TArray<uint8> UncompressedData;
+		FMemoryWriter MemoryWriter(UncompressedData, true);
+
+		int32 Version = FlowSave::WorldBlockVersion;
+		MemoryWriter << Version;
+		MemoryWriter << WorldRecords.Value.Components;
+		MemoryWriter << WorldRecords.Value.Instances;
+
+		FFlowWorldSaveBlock WorldBlock;
+		WorldBlock.WorldName = WorldRecords.Key;
+		WorldBlock.CompressionFormat = CompressionFormat;
+		WorldBlock.UncompressedSize = UncompressedData.Num();
+
+		bool bSuccess = true;
+		for (int32 Offset = 0; Offset < UncompressedData.Num() && bSuccess; Offset += FFlowWorldSaveBlock::ChunkSize)
+		{
+			const int32 ChunkSize = FMath::Min(FFlowWorldSaveBlock::ChunkSize, UncompressedData.Num() - Offset);
+
+			int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, ChunkSize);
+			const int32 CompressedOffset = WorldBlock.CompressedData.AddUninitialized(CompressedSize);
+
+			bSuccess = FCompression::CompressMemory(CompressionFormat, WorldBlock.CompressedData.GetData() + CompressedOffset, CompressedSize, UncompressedData.GetData() + Offset, ChunkSize);
+
+			WorldBlock.CompressedData.SetNumUninitialized(CompressedOffset + CompressedSize);
+			WorldBlock.CompressedChunkSizes.Add(CompressedSize);
+		}
+
+		if (bSuccess)
+		{
+			WorldBlocks.Emplace(MoveTemp(WorldBlock));
+		}
+		else
+		{
+			// keep records uncompressed, SaveGame remains valid
+			UE_LOG(LogFlow, Error, TEXT("Failed to compress Flow records of world %s with %s"), *WorldRecords.Key, *CompressionFormat.ToString());
+			FlowComponents.Append(MoveTemp(WorldRecords.Value.Components));
+			FlowInstances.Append(MoveTemp(WorldRecords.Value.Instances));
+		}
+	}
+}
+
+bool FFlowSaveGameRecords::UnpackWorldBlock(const FString& WorldName)
+{
+	const int32 BlockIndex = WorldBlocks.IndexOfByPredicate([&WorldName](const FFlowWorldSaveBlock& WorldBlock)
+	{
+		return WorldBlock.WorldName == WorldName;
+	});
+
+	if (BlockIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FFlowWorldSaveBlock& WorldBlock = WorldBlocks[BlockIndex];
+
+	// chunks have to cover the uncompressed size exactly and consume all compressed data, otherwise the block is corrupted
+	bool bSuccess = WorldBlock.UncompressedSize > 0
+		&& WorldBlock.CompressedChunkSizes.Num() == FMath::DivideAndRoundUp(WorldBlock.UncompressedSize, FFlowWorldSaveBlock::ChunkSize);
+
+	if (bSuccess)
+	{
+		int64 CompressedDataSize = 0;
+		for (const int32 CompressedSize : WorldBlock.CompressedChunkSizes)
+		{
+			bSuccess &= CompressedSize > 0;
+			CompressedDataSize += CompressedSize;
+		}
+
+		bSuccess &= CompressedDataSize == WorldBlock.CompressedData.Num();
+	}
+
+	TArray<uint8> UncompressedData;
+	if (bSuccess)
+	{
+		UncompressedData.SetNumUninitialized(WorldBlock.UncompressedSize);
+	}
+
+	int32 CompressedOffset = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < WorldBlock.CompressedChunkSizes.Num() && bSuccess; ChunkIndex++)
+	{
+		const int32 Offset = ChunkIndex * FFlowWorldSaveBlock::ChunkSize;
+		const int32 ChunkSize = FMath::Min(FFlowWorldSaveBlock::ChunkSize, WorldBlock.UncompressedSize - Offset);
+		const int32 CompressedSize = WorldBlock.CompressedChunkSizes[ChunkIndex];
+
+		bSuccess = FCompression::UncompressMemory(WorldBlock.CompressionFormat, UncompressedData.GetData() + Offset, ChunkSize, WorldBlock.CompressedData.GetData() + CompressedOffset, CompressedSize);
+
+		CompressedOffset += CompressedSize;
+	}
+
+	if (bSuccess)
+	{
+		FMemoryReader MemoryReader(UncompressedData, true);
+
+		int32 Version = 0;
+		MemoryReader << Version;
+
+		TArray<FFlowComponentSaveData> Components;
+		TArray<FFlowAssetSaveData> Instances;
+		if (Version == FlowSave::WorldBlockVersion)
+		{
+			MemoryReader << Components;
+			MemoryReader << Instances;
+		}
+
+		bSuccess = Version == FlowSave::WorldBlockVersion && !MemoryReader.IsError();
+		if (bSuccess)
+		{
+			FlowComponents.Append(MoveTemp(Components));
+			FlowInstances.Append(MoveTemp(Instances));
+		}
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogFlow, Error, TEXT("Failed to decompress Flow records of world %s, records are discarded"), *WorldName);
+	}
+
+	WorldBlocks.RemoveAt(BlockIndex);
+
+	return bSuccess;
+}
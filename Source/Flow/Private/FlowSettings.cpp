@@ -9,6 +9,17 @@ UFlowSettings::UFlowSettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bCreateFlowSubsystemOnClients(true)
 	, bWarnAboutMissingIdentityTags(true)
+	, bCompressSaveGame(false)
+	, SaveGameCompressionFormat(NAME_Zlib)
+	, bLightweightRouteNodes(false)
+	, bLightweightRouteNodesInEditor(false)
+	, bStripUnreachableNodesOnCook(false)
+	, bCollapsePassThroughNodes(true)
+	, bCollapsePassThroughNodesInEditor(false)
+	, MaxInlinedSubGraphNodes(0)
+	, ThrottledSignificance(0.0f)
+	, ThrottledTimersInterval(0.5f)
+	, bCleanupNodesOnWorldTeardown(true)
 	, bLogOnSignalDisabled(true)
 	, bLogOnSignalPassthrough(true)
 	, bUseAdaptiveNodeTitles(false)
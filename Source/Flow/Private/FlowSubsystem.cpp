@@ -9,8 +9,11 @@
 #include "FlowSettings.h"
 #include "Nodes/Route/FlowNode_SubGraph.h"
 
+#include "Async/Async.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "Kismet/GameplayStatics.h"
 #include "Logging/MessageLog.h"
 #include "Misc/Paths.h"
 #include "UObject/UObjectHash.h"
@@ -26,7 +29,13 @@ FNativeFlowAssetEvent UFlowSubsystem::OnInstancedTemplateRemoved;
 
 UFlowSubsystem::UFlowSubsystem()
 	: LoadedSaveGame(nullptr)
+	, NotifyQueue(MakeShared<FFlowNotifyQueue, ESPMode::ThreadSafe>())
+	, RegistrySnapshot(MakeShared<FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe>())
+	, PublishedRegistrySnapshot(RegistrySnapshot.Get())
+	, RegistrySnapshotEpoch(0)
 {
+	RegistrySnapshotReaders[0] = 0;
+	RegistrySnapshotReaders[1] = 0;
 }
 
 bool UFlowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -50,30 +59,59 @@ bool UFlowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void UFlowSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UFlowSubsystem::OnWorldCleanup);
 }
 
 void UFlowSubsystem::Deinitialize()
 {
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
 	AbortActiveFlows();
+	TimerWheel.Reset();
+
+	// other threads might still hold the queue, notifies queued from now on are dropped
+	NotifyQueue->Close();
+
+	// don't leave background saves referencing SaveGames we're about to release
+	UE::Tasks::Wait(PendingSaveTasks);
+	PendingSaveTasks.Empty();
+	PendingSaveGames.Empty();
 }
 
 void UFlowSubsystem::AbortActiveFlows()
 {
 	if (InstancedTemplates.Num() > 0)
 	{
-		for (int32 i = InstancedTemplates.Num() - 1; i >= 0; i--)
+		TSet<UFlowAsset*> Instances;
+		for (const UFlowAsset* InstancedTemplate : InstancedTemplates)
 		{
-			if (InstancedTemplates.IsValidIndex(i) && InstancedTemplates[i])
+			if (InstancedTemplate)
 			{
-				InstancedTemplates[i]->ClearInstances();
+				for (const TWeakObjectPtr<UFlowAsset>& Instance : InstancedTemplate->ActiveInstances)
+				{
+					if (Instance.IsValid())
+					{
+						Instances.Add(Instance.Get());
+					}
+				}
 			}
 		}
+
+		FinishInstancesInBulk(Instances, true);
 	}
 
 	InstancedTemplates.Empty();
 	InstancedSubFlows.Empty();
+	PooledSubFlows.Empty();
 
 	RootInstances.Empty();
+
+	for (TPair<FName, FFlowHibernatedInstance>& HibernatedInstance : HibernatedFlows)
+	{
+		TimerWheel.ClearTimer(HibernatedInstance.Value.WakeUpTimerHandle);
+	}
+	HibernatedFlows.Empty();
+	HibernatedFlowsByTag.Empty();
 }
 
 void UFlowSubsystem::StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances /* = true */)
@@ -105,6 +143,12 @@ UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset
 		}
 	}
 
+	if (!FindHibernatedInstance(Owner, FlowAsset).IsNone())
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow for the same Owner again, while it's hibernated. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
+		return nullptr;
+	}
+
 	if (!bAllowMultipleInstances && InstancedTemplates.Contains(FlowAsset))
 	{
 		UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow, although there can be only a single instance. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
@@ -120,6 +164,86 @@ UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset
 	return NewFlow;
 }
 
+void UFlowSubsystem::StartRootFlows(const TArray<FFlowRootFlowRequest>& Requests, TArray<UFlowAsset*>& OutInstances)
+{
+	OutInstances.Reset(Requests.Num());
+	OutInstances.AddZeroed(Requests.Num());
+
+	// pairs of owner and template are collected once, instead of scanning Root Instances for every request
+	TSet<TPair<const UObject*, const UFlowAsset*>> StartedRootFlows;
+	StartedRootFlows.Reserve(RootInstances.Num() + HibernatedFlows.Num() + Requests.Num());
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
+	{
+		if (RootInstance.Key)
+		{
+			StartedRootFlows.Emplace(RootInstance.Value.Get(), RootInstance.Key->GetTemplateAsset());
+		}
+	}
+	for (const TPair<FName, FFlowHibernatedInstance>& HibernatedInstance : HibernatedFlows)
+	{
+		StartedRootFlows.Emplace(HibernatedInstance.Value.Owner.Get(), HibernatedInstance.Value.TemplateAsset);
+	}
+
+	TMap<UFlowAsset*, int32> RequestsPerTemplate;
+	for (const FFlowRootFlowRequest& Request : Requests)
+	{
+		if (Request.FlowAsset)
+		{
+			RequestsPerTemplate.FindOrAdd(Request.FlowAsset)++;
+		}
+	}
+
+	// base names of new instances, resolved once per template
+	TMap<UFlowAsset*, FString> PreparedTemplates;
+	PreparedTemplates.Reserve(RequestsPerTemplate.Num());
+	RootInstances.Reserve(RootInstances.Num() + Requests.Num());
+
+	for (int32 Index = 0; Index < Requests.Num(); Index++)
+	{
+		UObject* Owner = Requests[Index].Owner;
+		UFlowAsset* FlowAsset = Requests[Index].FlowAsset;
+		if (Owner == nullptr || FlowAsset == nullptr)
+		{
+			continue;
+		}
+
+		if (StartedRootFlows.Contains(TPair<const UObject*, const UFlowAsset*>(Owner, FlowAsset)))
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow for the same Owner again. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
+			continue;
+		}
+
+		if (!Requests[Index].bAllowMultipleInstances && InstancedTemplates.Contains(FlowAsset))
+		{
+			UE_LOG(LogFlow, Warning, TEXT("Attempted to start Root Flow, although there can be only a single instance. Owner: %s. Flow Asset: %s."), *Owner->GetName(), *FlowAsset->GetName());
+			continue;
+		}
+
+		if (!PreparedTemplates.Contains(FlowAsset))
+		{
+			PrepareTemplate(FlowAsset);
+			FlowAsset->ActiveInstances.Reserve(FlowAsset->ActiveInstances.Num() + RequestsPerTemplate[FlowAsset]);
+			PreparedTemplates.Add(FlowAsset, FPaths::GetBaseFilename(FlowAsset->GetPathName()));
+		}
+
+		const FName InstanceName = MakeUniqueObjectName(this, UFlowAsset::StaticClass(), *PreparedTemplates[FlowAsset]);
+		UFlowAsset* NewInstance = InstantiateTemplate(Owner, FlowAsset, InstanceName);
+
+		RootInstances.Add(NewInstance, Owner);
+		StartedRootFlows.Emplace(Owner, FlowAsset);
+		OutInstances[Index] = NewInstance;
+	}
+
+	// instances are started once all of them exist, starting flow might already finish another one
+	for (UFlowAsset* NewInstance : OutInstances)
+	{
+		if (NewInstance && RootInstances.Contains(NewInstance))
+		{
+			NewInstance->StartFlow();
+		}
+	}
+}
+
 void UFlowSubsystem::FinishRootFlow(UObject* Owner, UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy)
 {
 	UFlowAsset* InstanceToFinish = nullptr;
@@ -138,6 +262,9 @@ void UFlowSubsystem::FinishRootFlow(UObject* Owner, UFlowAsset* TemplateAsset, c
 		RootInstances.Remove(InstanceToFinish);
 		InstanceToFinish->FinishFlow(FinishPolicy);
 	}
+
+	// hibernated instance has no active nodes, its record is simply discarded
+	RemoveHibernatedInstance(FindHibernatedInstance(Owner, TemplateAsset));
 }
 
 void UFlowSubsystem::FinishAllRootFlows(UObject* Owner, const EFlowFinishPolicy FinishPolicy)
@@ -157,6 +284,20 @@ void UFlowSubsystem::FinishAllRootFlows(UObject* Owner, const EFlowFinishPolicy
 		RootInstances.Remove(InstanceToFinish);
 		InstanceToFinish->FinishFlow(FinishPolicy);
 	}
+
+	TArray<FName> HibernatedInstancesToRemove;
+	for (const TPair<FName, FFlowHibernatedInstance>& HibernatedInstance : HibernatedFlows)
+	{
+		if (Owner && Owner == HibernatedInstance.Value.Owner.Get())
+		{
+			HibernatedInstancesToRemove.Emplace(HibernatedInstance.Key);
+		}
+	}
+
+	for (const FName& InstanceName : HibernatedInstancesToRemove)
+	{
+		RemoveHibernatedInstance(InstanceName);
+	}
 }
 
 UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString SavedInstanceName, const bool bPreloading /* = false */)
@@ -166,7 +307,17 @@ UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, cons
 	if (!InstancedSubFlows.Contains(SubGraphNode))
 	{
 		const TWeakObjectPtr<UObject> Owner = SubGraphNode->GetFlowAsset() ? SubGraphNode->GetFlowAsset()->GetOwner() : nullptr;
-		NewInstance = CreateFlowInstance(Owner, SubGraphNode->Asset, SavedInstanceName);
+
+		// instance restored from SaveGame needs its saved name, so it's never taken from the pool
+		if (SavedInstanceName.IsEmpty())
+		{
+			NewInstance = AcquirePooledSubFlow(Owner, SubGraphNode->Asset);
+		}
+
+		if (NewInstance == nullptr)
+		{
+			NewInstance = CreateFlowInstance(Owner, SubGraphNode->Asset, SavedInstanceName);
+		}
 
 		if (NewInstance)
 		{
@@ -207,8 +358,75 @@ void UFlowSubsystem::RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlow
 		SubGraphNode->GetFlowAsset()->ActiveSubGraphs.Remove(SubGraphNode);
 		InstancedSubFlows.Remove(SubGraphNode);
 
-		AssetInstance->FinishFlow(FinishPolicy);
+		if (!ReleaseSubFlowToPool(AssetInstance, FinishPolicy))
+		{
+			AssetInstance->FinishFlow(FinishPolicy);
+		}
+	}
+}
+
+void UFlowSubsystem::WarmSubFlowPool(UFlowNode_SubGraph* SubGraphNode)
+{
+	UFlowAsset* Template = SubGraphNode->Asset.LoadSynchronous();
+	if (Template == nullptr || Template->MaxPooledInstances <= 0)
+	{
+		return;
+	}
+
+	const FFlowInstancePool* Pool = PooledSubFlows.Find(Template);
+	const int32 InstancesToCreate = Template->MaxPooledInstances - (Pool ? Pool->Instances.Num() : 0);
+
+	const TWeakObjectPtr<UObject> Owner = SubGraphNode->GetFlowAsset() ? SubGraphNode->GetFlowAsset()->GetOwner() : nullptr;
+	for (int32 i = 0; i < InstancesToCreate; i++)
+	{
+		if (UFlowAsset* NewInstance = CreateFlowInstance(Owner, SubGraphNode->Asset))
+		{
+			ReleaseSubFlowToPool(NewInstance, EFlowFinishPolicy::Keep);
+		}
+	}
+}
+
+UFlowAsset* UFlowSubsystem::AcquirePooledSubFlow(const TWeakObjectPtr<UObject> Owner, const TSoftObjectPtr<UFlowAsset>& FlowAsset)
+{
+	UFlowAsset* Template = FlowAsset.Get();
+	FFlowInstancePool* Pool = Template ? PooledSubFlows.Find(Template) : nullptr;
+	if (Pool == nullptr || Pool->Instances.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	UFlowAsset* PooledInstance = Pool->Instances.Pop(false).Instance;
+
+	AddInstancedTemplate(Template);
+	PooledInstance->InitializePooledInstance(Owner);
+	Template->AddInstance(PooledInstance);
+
+	return PooledInstance;
+}
+
+bool UFlowSubsystem::ReleaseSubFlowToPool(UFlowAsset* AssetInstance, const EFlowFinishPolicy FinishPolicy)
+{
+	UFlowAsset* Template = AssetInstance->GetTemplateAsset();
+	if (Template == nullptr || Template->MaxPooledInstances <= 0 || bBulkTeardown)
+	{
+		return false;
+	}
+
+	FFlowInstancePool& Pool = PooledSubFlows.FindOrAdd(Template);
+	if (Pool.Instances.Num() >= Template->MaxPooledInstances)
+	{
+		return false;
 	}
+
+	FFlowPooledInstance& PooledInstance = Pool.Instances.AddDefaulted_GetRef();
+	PooledInstance.Instance = AssetInstance;
+	PooledInstance.World = AssetInstance->GetOwner() ? AssetInstance->GetOwner()->GetTypedOuter<UWorld>() : nullptr;
+
+	// deinitializes nodes and removes instance from the template, but node instances are kept
+	AssetInstance->FinishFlow(FinishPolicy);
+	AssetInstance->ResetPooledInstance();
+
+	return true;
 }
 
 UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName)
@@ -219,26 +437,34 @@ UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Own
 		return nullptr;
 	}
 
-	AddInstancedTemplate(LoadedFlowAsset);
+	PrepareTemplate(LoadedFlowAsset);
+
+	// it won't be empty, if we're restoring Flow Asset instance from the SaveGame
+	const FName InstanceName = NewInstanceName.IsEmpty() ? MakeUniqueObjectName(this, UFlowAsset::StaticClass(), *FPaths::GetBaseFilename(LoadedFlowAsset->GetPathName())) : FName(*NewInstanceName);
+
+	return InstantiateTemplate(Owner, LoadedFlowAsset, InstanceName);
+}
+
+void UFlowSubsystem::PrepareTemplate(UFlowAsset* Template)
+{
+	AddInstancedTemplate(Template);
 
 #if WITH_EDITOR
 	if (GetWorld()->WorldType != EWorldType::Game)
 	{
 		// Fix connections - even in packaged game if assets haven't been re-saved in the editor after changing node's definition
-		LoadedFlowAsset->HarvestNodeConnections();
+		Template->HarvestNodeConnections();
+		Template->CompileGraph();
 	}
 #endif
+}
 
-	// it won't be empty, if we're restoring Flow Asset instance from the SaveGame
-	if (NewInstanceName.IsEmpty())
-	{
-		NewInstanceName = MakeUniqueObjectName(this, UFlowAsset::StaticClass(), *FPaths::GetBaseFilename(LoadedFlowAsset->GetPathName())).ToString();
-	}
-
-	UFlowAsset* NewInstance = NewObject<UFlowAsset>(this, LoadedFlowAsset->GetClass(), *NewInstanceName, RF_Transient, LoadedFlowAsset, false, nullptr);
-	NewInstance->InitializeInstance(Owner, LoadedFlowAsset);
+UFlowAsset* UFlowSubsystem::InstantiateTemplate(const TWeakObjectPtr<UObject> Owner, UFlowAsset* Template, const FName InstanceName)
+{
+	UFlowAsset* NewInstance = NewObject<UFlowAsset>(this, Template->GetClass(), InstanceName, RF_Transient, Template, false, nullptr);
+	NewInstance->InitializeInstance(Owner, Template);
 
-	LoadedFlowAsset->AddInstance(NewInstance);
+	Template->AddInstance(NewInstance);
 
 	return NewInstance;
 }
@@ -305,32 +531,548 @@ UWorld* UFlowSubsystem::GetWorld() const
 	return GetGameInstance()->GetWorld();
 }
 
-void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
+void UFlowSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
 {
-	// clear existing data, in case we received reused SaveGame instance
-	// we only remove data for the current world + global Flow Graph instances (i.e. not bound to any world if created by UGameInstanceSubsystem)
-	// we keep data bound to other worlds
-	if (GetWorld())
+	// flows owned by actors without Flow Component weren't torn down yet
+	if (World && World == GetWorld())
+	{
+		TeardownWorldFlows(World);
+	}
+
+	for (UFlowAsset* InstancedTemplate : InstancedTemplates)
+	{
+		if (InstancedTemplate)
+		{
+			for (const TWeakObjectPtr<UFlowAsset>& Instance : InstancedTemplate->ActiveInstances)
+			{
+				if (Instance.IsValid() && Instance->CachedWorld == World)
+				{
+					Instance->InvalidateOwnerContext();
+				}
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::TeardownWorldFlows(UWorld* World)
+{
+	if (World == nullptr || IsWorldTornDown(World))
+	{
+		return;
+	}
+	TornDownWorld = World;
+
+	// Game Instance and its subsystems return the current world from GetWorld(), so the owner has to be placed in the ending world
+	const auto IsOwnedByWorld = [World](const TWeakObjectPtr<UObject>& Owner)
+	{
+		return Owner.IsStale() || (Owner.IsValid() && (Owner.Get() == World || Owner->GetTypedOuter<UWorld>() == World));
+	};
+
+	TSet<UFlowAsset*> Instances;
+	TSet<TObjectKey<UObject>> Owners;
+	for (const UFlowAsset* InstancedTemplate : InstancedTemplates)
+	{
+		if (InstancedTemplate)
+		{
+			for (const TWeakObjectPtr<UFlowAsset>& Instance : InstancedTemplate->ActiveInstances)
+			{
+				// flows not bound to the world survive the map change
+				if (Instance.IsValid() && Instance->IsBoundToWorld() && IsOwnedByWorld(Instance->Owner))
+				{
+					Instances.Add(Instance.Get());
+
+					// null key would match timers without owner
+					if (UObject* Owner = Instance->Owner.Get())
+					{
+						Owners.Add(Owner);
+					}
+				}
+			}
+		}
+	}
+
+	if (Instances.Num() > 0)
+	{
+		FinishInstancesInBulk(Instances, UFlowSettings::Get()->bCleanupNodesOnWorldTeardown);
+	}
+
+	for (auto It = HibernatedFlows.CreateIterator(); It; ++It)
+	{
+		UFlowAsset* HibernatedTemplate = It.Value().TemplateAsset;
+		if ((HibernatedTemplate == nullptr || HibernatedTemplate->IsBoundToWorld()) && IsOwnedByWorld(It.Value().Owner))
+		{
+			TimerWheel.ClearTimer(It.Value().WakeUpTimerHandle);
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = HibernatedFlowsByTag.CreateIterator(); It; ++It)
+	{
+		if (!HibernatedFlows.Contains(It.Value()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// registry is rebuilt at once, instead of unregistering every component
+	for (auto It = FlowComponentRegistry.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid() || It.Value()->GetWorld() == World)
+		{
+			if (UFlowComponent* Component = It.Value().Get())
+			{
+				Owners.Add(Component);
+			}
+			It.RemoveCurrent();
+		}
+	}
+	bRegistrySnapshotDirty = true;
+
+	DeferredNotifies.RemoveAll([World](const FDeferredNotify& DeferredNotify)
 	{
-		const FString& WorldName = GetWorld()->GetName();
+		return !DeferredNotify.Component.IsValid() || DeferredNotify.Component->GetWorld() == World;
+	});
 
-		for (int32 i = SaveGame->FlowInstances.Num() - 1; i >= 0; i--)
+	// nodes of pooled instances might still reference objects of the ending world
+	for (auto It = PooledSubFlows.CreateIterator(); It; ++It)
+	{
+		It.Value().Instances.RemoveAll([World](const FFlowPooledInstance& PooledInstance)
+		{
+			return PooledInstance.World.IsStale() || PooledInstance.World.Get() == World;
+		});
+
+		if (It.Value().Instances.Num() == 0)
 		{
-			if (SaveGame->FlowInstances[i].WorldName.IsEmpty() || SaveGame->FlowInstances[i].WorldName == WorldName)
+			It.RemoveCurrent();
+		}
+	}
+
+	// also removes timers of nodes that skipped Cleanup
+	TimerWheel.ClearAllTimers(Owners);
+}
+
+void UFlowSubsystem::FinishInstancesInBulk(const TSet<UFlowAsset*>& Instances, const bool bCleanupNodes)
+{
+	if (bCleanupNodes)
+	{
+		// Sub Graphs are finished by Sub Graph nodes of their parents
+		// list is collected first, as finishing Sub Graph clears its owning node
+		TArray<UFlowAsset*> TopInstances;
+		TopInstances.Reserve(Instances.Num());
+		for (UFlowAsset* Instance : Instances)
+		{
+			if (!Instance->NodeOwningThisAssetInstance.IsValid())
 			{
-				SaveGame->FlowInstances.RemoveAt(i);
+				TopInstances.Add(Instance);
 			}
 		}
 
-		for (int32 i = SaveGame->FlowComponents.Num() - 1; i >= 0; i--)
+		TGuardValue<bool> BulkTeardownGuard(bBulkTeardown, true);
+		for (UFlowAsset* Instance : TopInstances)
+		{
+			Instance->FinishFlow(EFlowFinishPolicy::Keep);
+		}
+	}
+
+	for (int32 i = InstancedTemplates.Num() - 1; i >= 0; i--)
+	{
+		UFlowAsset* InstancedTemplate = InstancedTemplates[i];
+		if (InstancedTemplate == nullptr)
+		{
+			continue;
+		}
+
+#if WITH_EDITOR
+		if (InstancedTemplate->InspectedInstance.IsValid() && Instances.Contains(InstancedTemplate->InspectedInstance.Get()))
+		{
+			InstancedTemplate->SetInspectedInstance(NAME_None);
+		}
+#endif
+
+		InstancedTemplate->ActiveInstances.RemoveAll([&Instances](const TWeakObjectPtr<UFlowAsset>& Instance)
+		{
+			return !Instance.IsValid() || Instances.Contains(Instance.Get());
+		});
+
+		if (InstancedTemplate->ActiveInstances.Num() == 0)
+		{
+			RemoveInstancedTemplate(InstancedTemplate);
+		}
+	}
+
+	for (auto It = RootInstances.CreateIterator(); It; ++It)
+	{
+		if (Instances.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = InstancedSubFlows.CreateIterator(); It; ++It)
+	{
+		if (Instances.Contains(It.Value()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UFlowSubsystem::Tick(float DeltaTime)
+{
+	FlushQueuedNotifies();
+
+	TimerWheel.Advance(DeltaTime);
+
+	ThrottledTimersElapsed += DeltaTime;
+	if (ThrottledTimersElapsed >= UFlowSettings::Get()->ThrottledTimersInterval)
+	{
+		ThrottledTimersElapsed = 0.0f;
+		TimerWheel.FlushThrottledTimers();
+	}
+
+	FlushDeferredNotifies();
+
+	if (bRegistrySnapshotDirty)
+	{
+		PublishRegistrySnapshot();
+	}
+}
+
+ETickableTickType UFlowSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFlowSubsystem::IsTickable() const
+{
+	return GetGameInstance() && GetWorld();
+}
+
+TStatId UFlowSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowSubsystem, STATGROUP_Tickables);
+}
+
+bool UFlowSubsystem::HibernateRootFlow(UObject* Owner, UFlowAsset* TemplateAsset)
+{
+	UFlowAsset* InstanceToHibernate = nullptr;
+
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
+	{
+		if (Owner && Owner == RootInstance.Value.Get() && RootInstance.Key && RootInstance.Key->GetTemplateAsset() == TemplateAsset)
+		{
+			InstanceToHibernate = RootInstance.Key;
+			break;
+		}
+	}
+
+	return InstanceToHibernate && HibernateInstance(InstanceToHibernate);
+}
+
+int32 UFlowSubsystem::HibernateIdleRootFlows()
+{
+	TArray<UFlowAsset*> InstancesToHibernate;
+	RootInstances.GenerateKeyArray(InstancesToHibernate);
+
+	int32 HibernatedInstances = 0;
+	for (UFlowAsset* Instance : InstancesToHibernate)
+	{
+		if (Instance && HibernateInstance(Instance))
+		{
+			HibernatedInstances++;
+		}
+	}
+
+	return HibernatedInstances;
+}
+
+void UFlowSubsystem::WakeUpRootFlow(UObject* Owner, UFlowAsset* TemplateAsset)
+{
+	const FName InstanceName = FindHibernatedInstance(Owner, TemplateAsset);
+	if (!InstanceName.IsNone())
+	{
+		WakeUpInstance(InstanceName);
+	}
+}
+
+bool UFlowSubsystem::IsRootFlowHibernated(const UObject* Owner, const UFlowAsset* TemplateAsset) const
+{
+	return !FindHibernatedInstance(Owner, TemplateAsset).IsNone();
+}
+
+bool UFlowSubsystem::HibernateInstance(UFlowAsset* AssetInstance)
+{
+	const TWeakObjectPtr<UObject> Owner = RootInstances.FindRef(AssetInstance);
+
+	FFlowWakeUpConditions WakeUpConditions;
+	if (!Owner.IsValid() || !AssetInstance->CanHibernate(WakeUpConditions))
+	{
+		return false;
+	}
+
+	const FName InstanceName = AssetInstance->GetFName();
+	FFlowHibernatedInstance& HibernatedInstance = HibernatedFlows.Add(InstanceName);
+	HibernatedInstance.TemplateAsset = AssetInstance->GetTemplateAsset();
+	HibernatedInstance.Owner = Owner;
+	HibernatedInstance.WakeUpConditions = WakeUpConditions;
+
+	// instance without active Sub Graphs is saved to a single record
+	TArray<FFlowAssetSaveData> SavedFlowInstances;
+	HibernatedInstance.Record = AssetInstance->SaveInstance(SavedFlowInstances);
+
+	for (const FGameplayTag& Tag : WakeUpConditions.IdentityTags)
+	{
+		HibernatedFlowsByTag.Add(Tag, InstanceName);
+	}
+
+	if (WakeUpConditions.Delay > UE_KINDA_SMALL_NUMBER)
+	{
+		HibernatedInstance.WakeUpTimerHandle = TimerWheel.SetTimer(Owner.Get(), FFlowTimerDelegate::CreateUObject(this, &UFlowSubsystem::OnWakeUpTimer, InstanceName), WakeUpConditions.Delay, false);
+	}
+	else if (WakeUpConditions.Delay >= 0.0f)
+	{
+		HibernatedInstance.WakeUpTimerHandle = TimerWheel.SetTimerForNextTick(Owner.Get(), FFlowTimerDelegate::CreateUObject(this, &UFlowSubsystem::OnWakeUpTimer, InstanceName));
+	}
+
+	// nodes are only deactivated, Keep policy leaves the world as it is
+	RootInstances.Remove(AssetInstance);
+	AssetInstance->FinishFlow(EFlowFinishPolicy::Keep);
+	AssetInstance->MarkAsGarbage();
+
+	return true;
+}
+
+void UFlowSubsystem::WakeUpInstance(const FName& InstanceName)
+{
+	const FFlowHibernatedInstance* FoundInstance = HibernatedFlows.Find(InstanceName);
+	if (FoundInstance == nullptr)
+	{
+		return;
+	}
+
+	const FFlowHibernatedInstance HibernatedInstance = *FoundInstance;
+
+	float TimeInHibernation = 0.0f;
+	if (HibernatedInstance.WakeUpTimerHandle.IsValid())
+	{
+		TimeInHibernation = TimerWheel.GetTimerElapsed(HibernatedInstance.WakeUpTimerHandle);
+	}
+	else if (HibernatedInstance.WakeUpConditions.Delay >= 0.0f)
+	{
+		// wake-up timer has just completed
+		TimeInHibernation = HibernatedInstance.WakeUpConditions.Delay;
+	}
+
+	// removed before restoring, so events triggered while loading won't wake up this instance again
+	RemoveHibernatedInstance(InstanceName);
+
+	UObject* Owner = HibernatedInstance.Owner.Get();
+	if (Owner == nullptr || HibernatedInstance.TemplateAsset == nullptr)
+	{
+		return;
+	}
+
+	if (UFlowAsset* RestoredInstance = CreateRootFlow(Owner, HibernatedInstance.TemplateAsset))
+	{
+		HibernatedTime = TimeInHibernation;
+		RestoredInstance->LoadInstance(HibernatedInstance.Record);
+		HibernatedTime = 0.0f;
+	}
+}
+
+void UFlowSubsystem::RemoveHibernatedInstance(const FName& InstanceName)
+{
+	if (FFlowHibernatedInstance* HibernatedInstance = HibernatedFlows.Find(InstanceName))
+	{
+		TimerWheel.ClearTimer(HibernatedInstance->WakeUpTimerHandle);
+
+		for (const FGameplayTag& Tag : HibernatedInstance->WakeUpConditions.IdentityTags)
+		{
+			HibernatedFlowsByTag.RemoveSingle(Tag, InstanceName);
+		}
+
+		HibernatedFlows.Remove(InstanceName);
+	}
+}
+
+FName UFlowSubsystem::FindHibernatedInstance(const UObject* Owner, const UFlowAsset* TemplateAsset) const
+{
+	for (const TPair<FName, FFlowHibernatedInstance>& HibernatedInstance : HibernatedFlows)
+	{
+		if (Owner && Owner == HibernatedInstance.Value.Owner.Get() && HibernatedInstance.Value.TemplateAsset == TemplateAsset)
+		{
+			return HibernatedInstance.Key;
+		}
+	}
+
+	return NAME_None;
+}
+
+void UFlowSubsystem::WakeUpHibernatedFlows(const UFlowComponent* Component, const FGameplayTag& NotifyTag)
+{
+	if (HibernatedFlows.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FName> InstancesToWakeUp;
+	for (const FGameplayTag& IdentityTag : Component->IdentityTags)
+	{
+		// parent tags are included, as observing nodes might not require the exact match
+		for (const FGameplayTag& Tag : IdentityTag.GetGameplayTagParents())
 		{
-			if (SaveGame->FlowComponents[i].WorldName.IsEmpty() || SaveGame->FlowComponents[i].WorldName == WorldName)
+			for (TMultiMap<FGameplayTag, FName>::TConstKeyIterator It(HibernatedFlowsByTag, Tag); It; ++It)
 			{
-				SaveGame->FlowComponents.RemoveAt(i);
+				const FFlowWakeUpConditions& WakeUpConditions = HibernatedFlows.FindChecked(It.Value()).WakeUpConditions;
+				if (!NotifyTag.IsValid() || WakeUpConditions.bAnyNotifyTag || WakeUpConditions.NotifyTags.HasTagExact(NotifyTag))
+				{
+					InstancesToWakeUp.AddUnique(It.Value());
+				}
 			}
 		}
 	}
 
+	for (const FName& InstanceName : InstancesToWakeUp)
+	{
+		WakeUpInstance(InstanceName);
+	}
+}
+
+void UFlowSubsystem::OnWakeUpTimer(const FName InstanceName)
+{
+	if (FFlowHibernatedInstance* HibernatedInstance = HibernatedFlows.Find(InstanceName))
+	{
+		// completed timer doesn't need to be cleared
+		HibernatedInstance->WakeUpTimerHandle.Invalidate();
+		WakeUpInstance(InstanceName);
+	}
+}
+
+void UFlowSubsystem::SetOwnerThrottled(const UObject* Owner, const bool bThrottled)
+{
+	TimerWheel.SetThrottled(Owner, bThrottled);
+
+	if (!bThrottled)
+	{
+		if (const UFlowComponent* FlowComponent = Cast<UFlowComponent>(Owner))
+		{
+			FlushDeferredNotifies(FlowComponent);
+		}
+	}
+}
+
+void UFlowSubsystem::DeferNotify(UFlowComponent* Component, const FGameplayTag& NotifyTag)
+{
+	DeferredNotifies.Add({Component, NotifyTag});
+}
+
+void UFlowSubsystem::FlushDeferredNotifies(const UFlowComponent* OnlyComponent)
+{
+	if (DeferredNotifies.Num() == 0)
+	{
+		return;
+	}
+
+	// notifies sent while broadcasting will wait for the next flush
+	TArray<FDeferredNotify> NotifiesToBroadcast;
+	const TArray<FDeferredNotify> AllNotifies = MoveTemp(DeferredNotifies);
+	DeferredNotifies.Reset();
+
+	for (const FDeferredNotify& DeferredNotify : AllNotifies)
+	{
+		if (OnlyComponent == nullptr || DeferredNotify.Component == OnlyComponent)
+		{
+			NotifiesToBroadcast.Add(DeferredNotify);
+		}
+		else
+		{
+			DeferredNotifies.Add(DeferredNotify);
+		}
+	}
+
+	for (const FDeferredNotify& DeferredNotify : NotifiesToBroadcast)
+	{
+		if (UFlowComponent* Component = DeferredNotify.Component.Get())
+		{
+			Component->BroadcastNotify(DeferredNotify.NotifyTag);
+		}
+	}
+}
+
+void UFlowSubsystem::QueueNotifyGraph(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode)
+{
+	NotifyQueue->QueueNotifyGraph(Component, NotifyTag, NetMode);
+}
+
+void UFlowSubsystem::QueueNotifyActor(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode)
+{
+	NotifyQueue->QueueNotifyActor(Component, ActorTag, NotifyTag, NetMode);
+}
+
+void UFlowSubsystem::QueueCustomInput(const TWeakObjectPtr<UFlowAsset>& FlowInstance, const FName& EventName)
+{
+	NotifyQueue->QueueCustomInput(FlowInstance, EventName);
+}
+
+void UFlowSubsystem::FlushQueuedNotifies()
+{
+	if (NotifyQueue->IsEmpty())
+	{
+		return;
+	}
+
+	// notifies queued while sending these will wait for the next tick
+	TArray<FFlowNotifyQueue::FQueuedNotify> Notifies;
+	TMap<uint32, int32> LastNotifyByProducer;
+
+	FFlowNotifyQueue::FQueuedNotify Notify;
+	while (NotifyQueue->Dequeue(Notify))
+	{
+		// only repeats of the previous notify from the same thread are collapsed, so A, B, A is still sent in full
+		int32& LastIndex = LastNotifyByProducer.FindOrAdd(Notify.ProducerId, INDEX_NONE);
+		if (LastIndex == INDEX_NONE || !(Notifies[LastIndex] == Notify))
+		{
+			LastIndex = Notifies.Add(MoveTemp(Notify));
+		}
+	}
+
+	for (const FFlowNotifyQueue::FQueuedNotify& QueuedNotify : Notifies)
+	{
+		switch (QueuedNotify.Type)
+		{
+			case FFlowNotifyQueue::FQueuedNotify::EType::Graph:
+				if (UFlowComponent* Component = Cast<UFlowComponent>(QueuedNotify.Target.Get()))
+				{
+					Component->NotifyGraph(QueuedNotify.NotifyTag, QueuedNotify.NetMode);
+				}
+				break;
+			case FFlowNotifyQueue::FQueuedNotify::EType::Actor:
+				if (UFlowComponent* Component = Cast<UFlowComponent>(QueuedNotify.Target.Get()))
+				{
+					Component->NotifyActor(QueuedNotify.ActorTag, QueuedNotify.NotifyTag, QueuedNotify.NetMode);
+				}
+				break;
+			case FFlowNotifyQueue::FQueuedNotify::EType::CustomInput:
+				if (UFlowAsset* FlowInstance = Cast<UFlowAsset>(QueuedNotify.Target.Get()))
+				{
+					FlowInstance->TriggerCustomInput(QueuedNotify.EventName);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
+{
+	// clear existing data, in case we received reused SaveGame instance
+	// we only remove data for the current world + global Flow Graph instances (i.e. not bound to any world if created by UGameInstanceSubsystem)
+	// we keep data bound to other worlds
+	if (GetWorld())
+	{
+		SaveGame->RemoveWorldRecords(GetWorld()->GetName());
+	}
+
 	// save Flow Graphs
 	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
 	{
@@ -347,6 +1089,20 @@ void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
 		}
 	}
 
+	// hibernated Flow Graphs are saved as they were at the moment of hibernation
+	for (const TPair<FName, FFlowHibernatedInstance>& HibernatedInstance : HibernatedFlows)
+	{
+		if (HibernatedInstance.Value.Owner.IsValid())
+		{
+			SaveGame->FlowInstances.Emplace(HibernatedInstance.Value.Record);
+
+			if (UFlowComponent* FlowComponent = Cast<UFlowComponent>(HibernatedInstance.Value.Owner))
+			{
+				FlowComponent->SavedAssetInstanceName = HibernatedInstance.Value.Record.InstanceName;
+			}
+		}
+	}
+
 	// save Flow Components
 	{
 		// retrieve all registered components
@@ -362,34 +1118,127 @@ void UFlowSubsystem::OnGameSaved(UFlowSaveGame* SaveGame)
 			SaveGame->FlowComponents.Emplace(RegisteredComponent->SaveInstance());
 		}
 	}
+
+	// records were appended, lookup will be rebuilt on demand
+	SaveGame->InvalidateWorldIndexes();
 }
 
 void UFlowSubsystem::OnGameLoaded(UFlowSaveGame* SaveGame)
 {
 	LoadedSaveGame = SaveGame;
 
+	if (LoadedSaveGame)
+	{
+		LoadedSaveGame->BuildWorldIndexes();
+	}
+
 	// here's opportunity to apply loaded data to custom systems
 	// it's recommended to do this by overriding method in the subclass
 }
 
-void UFlowSubsystem::LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName)
+void UFlowSubsystem::SaveGameToSlotAsync(UFlowSaveGame* SaveGame, const int32 UserIndex, const FFlowSaveGameCompleted& OnCompleted)
 {
-	if (FlowAsset == nullptr || SavedAssetInstanceName.IsEmpty())
+	if (SaveGame == nullptr)
 	{
+		OnCompleted.ExecuteIfBound(nullptr, false);
 		return;
 	}
 
-	for (const FFlowAssetSaveData& AssetRecord : LoadedSaveGame->FlowInstances)
+	// phase 1, game thread: capture raw payloads of Flow Graphs and Flow Components
+	OnGameSaved(SaveGame);
+	PendingSaveGames.Add(SaveGame);
+
+	const FName CompressionFormat = UFlowSettings::Get()->bCompressSaveGame ? UFlowSettings::Get()->SaveGameCompressionFormat : NAME_None;
+	if (CompressionFormat.IsNone())
+	{
+		WriteSaveGameToSlot(SaveGame, UserIndex, OnCompleted);
+		return;
+	}
+
+	// phase 2, worker thread: compress records moved out of the SaveGame, SaveGame object is accessed only on the game thread
+	FFlowSaveGameRecords Records;
+	SaveGame->SwapRecords(Records);
+
+	const TWeakObjectPtr<UFlowSubsystem> WeakThis(this);
+	const TWeakObjectPtr<UFlowSaveGame> WeakSaveGame(SaveGame);
+	PendingSaveTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, WeakSaveGame, Records = MoveTemp(Records), CompressionFormat, UserIndex, OnCompleted]() mutable
 	{
-		if (AssetRecord.InstanceName == SavedAssetInstanceName
-			&& (FlowAsset->IsBoundToWorld() == false || AssetRecord.WorldName == GetWorld()->GetName()))
+		Records.PackWorldBlocks(CompressionFormat);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakSaveGame, Records = MoveTemp(Records), UserIndex, OnCompleted]() mutable
 		{
-			UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, false);
-			if (LoadedInstance)
+			// packed records are returned to the SaveGame, even if the subsystem is gone
+			UFlowSaveGame* SaveGame = WeakSaveGame.Get();
+			if (SaveGame)
+			{
+				SaveGame->SwapRecords(Records);
+			}
+
+			UFlowSubsystem* FlowSubsystem = WeakThis.Get();
+			if (FlowSubsystem && SaveGame)
 			{
-				LoadedInstance->LoadInstance(AssetRecord);
+				FlowSubsystem->WriteSaveGameToSlot(SaveGame, UserIndex, OnCompleted);
 			}
-			return;
+		});
+	}));
+}
+
+void UFlowSubsystem::WriteSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, const FFlowSaveGameCompleted& OnCompleted)
+{
+	// phase 3: SaveGame is serialized on the game thread, only writing the bytes to the slot happens on a worker thread
+	TArray<uint8> SaveData;
+	if (!UGameplayStatics::SaveGameToMemory(SaveGame, SaveData))
+	{
+		OnSaveGameWritten(SaveGame, false, OnCompleted);
+		return;
+	}
+
+	const TWeakObjectPtr<UFlowSubsystem> WeakThis(this);
+	const FString SlotName = SaveGame->SaveSlotName;
+
+	PendingSaveTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, SaveGame, SaveData = MoveTemp(SaveData), SlotName, UserIndex, OnCompleted]()
+	{
+		const bool bSuccess = UGameplayStatics::SaveDataToSlot(SaveData, SlotName, UserIndex);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SaveGame, bSuccess, OnCompleted]()
+		{
+			if (UFlowSubsystem* FlowSubsystem = WeakThis.Get())
+			{
+				FlowSubsystem->OnSaveGameWritten(SaveGame, bSuccess, OnCompleted);
+			}
+		});
+	}));
+}
+
+void UFlowSubsystem::OnSaveGameWritten(UFlowSaveGame* SaveGame, const bool bSuccess, const FFlowSaveGameCompleted& OnCompleted)
+{
+	PendingSaveGames.Remove(SaveGame);
+	PendingSaveTasks.RemoveAll([](const UE::Tasks::FTask& Task)
+	{
+		return Task.IsCompleted();
+	});
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogFlow, Error, TEXT("Failed to write SaveGame to slot %s"), *SaveGame->SaveSlotName);
+	}
+
+	OnCompleted.ExecuteIfBound(SaveGame, bSuccess);
+}
+
+void UFlowSubsystem::LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName)
+{
+	if (FlowAsset == nullptr || SavedAssetInstanceName.IsEmpty())
+	{
+		return;
+	}
+
+	if (const FFlowAssetSaveData* AssetRecord = FindInstanceRecord(FlowAsset, SavedAssetInstanceName))
+	{
+		UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, false);
+		if (LoadedInstance)
+		{
+			LoadedInstance->LoadInstance(*AssetRecord);
 		}
 	}
 }
@@ -403,21 +1252,39 @@ void UFlowSubsystem::LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString
 
 	UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
 
-	for (const FFlowAssetSaveData& AssetRecord : LoadedSaveGame->FlowInstances)
+	if (const FFlowAssetSaveData* AssetRecord = FindInstanceRecord(SubGraphAsset, SavedAssetInstanceName))
 	{
-		if (AssetRecord.InstanceName == SavedAssetInstanceName
-			&& ((SubGraphAsset && SubGraphAsset->IsBoundToWorld() == false) || AssetRecord.WorldName == GetWorld()->GetName()))
+		UFlowAsset* LoadedInstance = CreateSubFlow(SubGraphNode, SavedAssetInstanceName);
+		if (LoadedInstance)
 		{
-			UFlowAsset* LoadedInstance = CreateSubFlow(SubGraphNode, SavedAssetInstanceName);
-			if (LoadedInstance)
-			{
-				LoadedInstance->LoadInstance(AssetRecord);
-			}
-			return;
+			LoadedInstance->LoadInstance(*AssetRecord);
 		}
 	}
 }
 
+const FFlowAssetSaveData* UFlowSubsystem::FindInstanceRecord(UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName) const
+{
+	if (LoadedSaveGame == nullptr)
+	{
+		return nullptr;
+	}
+
+	// decompress everything that might be requested while loading this asset and its Sub Graphs
+	// otherwise a nested request could move the record we're currently loading
+	LoadedSaveGame->UnpackWorldBlocks(GetWorld()->GetName());
+
+	// assets not bound to world are saved without world name
+	if (FlowAsset && FlowAsset->IsBoundToWorld() == false)
+	{
+		if (const FFlowAssetSaveData* AssetRecord = LoadedSaveGame->FindInstanceRecord(FString(), SavedAssetInstanceName))
+		{
+			return AssetRecord;
+		}
+	}
+
+	return LoadedSaveGame->FindInstanceRecord(GetWorld()->GetName(), SavedAssetInstanceName);
+}
+
 void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
 {
 	for (const FGameplayTag& Tag : Component->IdentityTags)
@@ -428,12 +1295,23 @@ void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
 		}
 	}
 
+	bRegistrySnapshotDirty = true;
+
+	// significance outlives the registration, i.e. if the component was unregistered while being insignificant
+	if (Component->IsThrottled())
+	{
+		SetOwnerThrottled(Component, true);
+	}
+
+	WakeUpHibernatedFlows(Component);
 	OnComponentRegistered.Broadcast(Component);
 }
 
 void UFlowSubsystem::OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag)
 {
 	FlowComponentRegistry.Emplace(AddedTag, Component);
+	bRegistrySnapshotDirty = true;
+	WakeUpHibernatedFlows(Component);
 
 	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
 	if (Component->IdentityTags.Num() > 1)
@@ -452,6 +1330,8 @@ void UFlowSubsystem::OnIdentityTagsAdded(UFlowComponent* Component, const FGamep
 	{
 		FlowComponentRegistry.Emplace(Tag, Component);
 	}
+	bRegistrySnapshotDirty = true;
+	WakeUpHibernatedFlows(Component);
 
 	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
 	if (Component->IdentityTags.Num() > AddedTags.Num())
@@ -473,6 +1353,17 @@ void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
 			FlowComponentRegistry.Remove(Tag, Component);
 		}
 	}
+	bRegistrySnapshotDirty = true;
+
+	// deferred work isn't executed in the middle of unregistering, flows of the component are already finished
+	if (IsOwnerThrottled(Component))
+	{
+		TimerWheel.ClearThrottled(Component);
+	}
+	DeferredNotifies.RemoveAll([Component](const FDeferredNotify& DeferredNotify)
+	{
+		return DeferredNotify.Component == Component;
+	});
 
 	OnComponentUnregistered.Broadcast(Component);
 }
@@ -480,6 +1371,7 @@ void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
 void UFlowSubsystem::OnIdentityTagRemoved(UFlowComponent* Component, const FGameplayTag& RemovedTag)
 {
 	FlowComponentRegistry.Remove(RemovedTag, Component);
+	bRegistrySnapshotDirty = true;
 
 	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
 	if (Component->IdentityTags.Num() > 0)
@@ -498,6 +1390,7 @@ void UFlowSubsystem::OnIdentityTagsRemoved(UFlowComponent* Component, const FGam
 	{
 		FlowComponentRegistry.Remove(Tag, Component);
 	}
+	bRegistrySnapshotDirty = true;
 
 	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
 	if (Component->IdentityTags.Num() > 0)
@@ -612,6 +1505,64 @@ TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTags(
 	return Result;
 }
 
+FFlowComponentRegistrySnapshotRef UFlowSubsystem::GetRegistrySnapshot() const
+{
+	// reader counted in the epoch it observed, publish can't flip the epoch between reading it and counting the reader
+	uint32 Epoch = RegistrySnapshotEpoch.load();
+	while (true)
+	{
+		RegistrySnapshotReaders[Epoch & 1]++;
+
+		const uint32 CurrentEpoch = RegistrySnapshotEpoch.load();
+		if (CurrentEpoch == Epoch)
+		{
+			break;
+		}
+
+		RegistrySnapshotReaders[Epoch & 1]--;
+		Epoch = CurrentEpoch;
+	}
+
+	// snapshot loaded in this epoch isn't released until the reader is gone, so it's safe to add the reference
+	FFlowComponentRegistrySnapshotRef Snapshot = PublishedRegistrySnapshot.load()->AsShared();
+	RegistrySnapshotReaders[Epoch & 1]--;
+
+	return Snapshot;
+}
+
+void UFlowSubsystem::PublishRegistrySnapshot()
+{
+	// epoch of the retired snapshot is about to be reused by readers
+	ReleaseRetiredRegistrySnapshot();
+
+	RetiredRegistrySnapshot = RegistrySnapshot;
+	RegistrySnapshot = MakeShared<FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe>(FlowComponentRegistry, GFrameCounter);
+
+	// readers counted in the new epoch can only load the new snapshot
+	PublishedRegistrySnapshot.store(RegistrySnapshot.Get());
+	RegistrySnapshotEpoch++;
+
+	bRegistrySnapshotDirty = false;
+}
+
+void UFlowSubsystem::ReleaseRetiredRegistrySnapshot()
+{
+	if (!RetiredRegistrySnapshot.IsValid())
+	{
+		return;
+	}
+
+	// retired snapshot was replaced a frame ago, readers of its epoch usually finished long ago
+	// the remaining readers are only copying the pointer, so this waits at most for their time slice
+	const uint32 RetiredEpoch = RegistrySnapshotEpoch.load() - 1;
+	while (RegistrySnapshotReaders[RetiredEpoch & 1].load() > 0)
+	{
+		FPlatformProcess::Yield();
+	}
+
+	RetiredRegistrySnapshot.Reset();
+}
+
 void UFlowSubsystem::FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
 {
 	if (bExactMatch)
@@ -0,0 +1,557 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowTimerWheel.h"
+
+FFlowTimerWheel::FFlowTimerWheel()
+	: CurrentTime(0.0)
+	, CurrentTick(0)
+	, NextSerial(0)
+	, NumActiveTimers(0)
+{
+	BucketHeads.Init(INDEX_NONE, NumBuckets);
+}
+
+FFlowTimerHandle FFlowTimerWheel::SetTimer(const UObject* Owner, const FFlowTimerDelegate& Delegate, const float Rate, const bool bLoop, const float FirstDelay /* = -1.0f */)
+{
+	const int32 Index = AllocateTimer();
+
+	FTimer& Timer = Timers[Index];
+	Timer.Delegate = Delegate;
+	Timer.Owner = TObjectKey<UObject>(Owner);
+	Timer.Rate = FMath::Max(0.0f, Rate);
+	Timer.bLoop = bLoop && Timer.Rate > 0.0f;
+
+	const float Delay = FirstDelay >= 0.0f ? FirstDelay : Timer.Rate;
+	Timer.CycleDuration = Delay;
+	Schedule(Index, Delay, GetTimeDilation(Owner));
+
+	FFlowTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Timer.Serial;
+	return Handle;
+}
+
+FFlowTimerHandle FFlowTimerWheel::SetTimerForNextTick(const UObject* Owner, const FFlowTimerDelegate& Delegate)
+{
+	const int32 Index = AllocateTimer();
+
+	FTimer& Timer = Timers[Index];
+	Timer.Delegate = Delegate;
+	Timer.Owner = TObjectKey<UObject>(Owner);
+	Timer.ExpireTime = CurrentTime;
+	Link(Index, NextTickBucket);
+
+	FFlowTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Timer.Serial;
+	return Handle;
+}
+
+void FFlowTimerWheel::ClearTimer(FFlowTimerHandle& Handle)
+{
+	if (FindTimer(Handle))
+	{
+		Unlink(Handle.Index);
+		FreeTimer(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+void FFlowTimerWheel::ClearAllTimers(const UObject* Owner)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+	for (int32 Index = 0; Index < Timers.Num(); Index++)
+	{
+		if (Timers[Index].bAllocated && Timers[Index].Owner == OwnerKey)
+		{
+			Unlink(Index);
+			FreeTimer(Index);
+		}
+	}
+}
+
+void FFlowTimerWheel::ClearAllTimers(const TSet<TObjectKey<UObject>>& Owners)
+{
+	if (Owners.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < Timers.Num(); Index++)
+	{
+		if (Timers[Index].bAllocated && Owners.Contains(Timers[Index].Owner))
+		{
+			Unlink(Index);
+			FreeTimer(Index);
+		}
+	}
+
+	for (const TObjectKey<UObject>& Owner : Owners)
+	{
+		OwnerTimeDilations.Remove(Owner);
+		ThrottledOwners.Remove(Owner);
+	}
+}
+
+bool FFlowTimerWheel::IsTimerActive(const FFlowTimerHandle& Handle) const
+{
+	return FindTimer(Handle) != nullptr;
+}
+
+float FFlowTimerWheel::GetTimerRemaining(const FFlowTimerHandle& Handle) const
+{
+	const FTimer* Timer = FindTimer(Handle);
+	return Timer ? GetRemaining(*Timer) : -1.0f;
+}
+
+float FFlowTimerWheel::GetTimerElapsed(const FFlowTimerHandle& Handle) const
+{
+	const FTimer* Timer = FindTimer(Handle);
+	return Timer ? FMath::Max(0.0f, Timer->CycleDuration - GetRemaining(*Timer)) : -1.0f;
+}
+
+void FFlowTimerWheel::SetTimeDilation(const UObject* Owner, const float TimeDilation)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+	const float NewDilation = FMath::Max(0.0f, TimeDilation);
+	if (FMath::IsNearlyEqual(GetTimeDilation(OwnerKey), NewDilation))
+	{
+		return;
+	}
+
+	// capture remaining time using the previous dilation
+	TArray<TPair<int32, float>> OwnerTimers;
+	for (int32 Index = 0; Index < Timers.Num(); Index++)
+	{
+		const FTimer& Timer = Timers[Index];
+		if (Timer.bAllocated && Timer.Owner == OwnerKey && Timer.Bucket != NextTickBucket && Timer.Bucket != FiringBucket && Timer.Bucket != DeferredBucket)
+		{
+			OwnerTimers.Emplace(Index, GetRemaining(Timer));
+		}
+	}
+
+	if (FMath::IsNearlyEqual(NewDilation, 1.0f))
+	{
+		OwnerTimeDilations.Remove(OwnerKey);
+	}
+	else
+	{
+		OwnerTimeDilations.Add(OwnerKey, NewDilation);
+	}
+
+	for (const TPair<int32, float>& OwnerTimer : OwnerTimers)
+	{
+		Unlink(OwnerTimer.Key);
+		Schedule(OwnerTimer.Key, OwnerTimer.Value, NewDilation);
+	}
+}
+
+float FFlowTimerWheel::GetTimeDilation(const UObject* Owner) const
+{
+	return GetTimeDilation(TObjectKey<UObject>(Owner));
+}
+
+float FFlowTimerWheel::GetTimeDilation(const TObjectKey<UObject>& OwnerKey) const
+{
+	const float* TimeDilation = OwnerTimeDilations.Find(OwnerKey);
+	return TimeDilation ? *TimeDilation : 1.0f;
+}
+
+void FFlowTimerWheel::SetThrottled(const UObject* Owner, const bool bThrottled)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+	if (bThrottled)
+	{
+		ThrottledOwners.Add(OwnerKey);
+		return;
+	}
+
+	if (ThrottledOwners.Remove(OwnerKey) == 0)
+	{
+		return;
+	}
+
+	// catch up with calls deferred while the owner was throttled, other owners keep their calls
+	TArray<FDeferredCall> OwnerCalls;
+	const TArray<FDeferredCall> AllCalls = MoveTemp(DeferredCalls);
+	DeferredCalls.Reset();
+
+	for (const FDeferredCall& DeferredCall : AllCalls)
+	{
+		if (Timers[DeferredCall.Index].Owner == OwnerKey)
+		{
+			OwnerCalls.Add(DeferredCall);
+		}
+		else
+		{
+			DeferredCalls.Add(DeferredCall);
+		}
+	}
+
+	for (const FDeferredCall& DeferredCall : OwnerCalls)
+	{
+		ExecuteDeferredCall(DeferredCall);
+	}
+}
+
+bool FFlowTimerWheel::IsThrottled(const UObject* Owner) const
+{
+	return ThrottledOwners.Num() > 0 && ThrottledOwners.Contains(TObjectKey<UObject>(Owner));
+}
+
+void FFlowTimerWheel::ClearThrottled(const UObject* Owner)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+	if (ThrottledOwners.Remove(OwnerKey) == 0)
+	{
+		return;
+	}
+
+	DeferredCalls.RemoveAll([this, &OwnerKey](const FDeferredCall& DeferredCall)
+	{
+		FTimer& Timer = Timers[DeferredCall.Index];
+		if (!Timer.bAllocated || Timer.Serial != DeferredCall.Serial || Timer.Owner != OwnerKey)
+		{
+			return false;
+		}
+
+		// expired timer is kept allocated only for its deferred call
+		if (Timer.Bucket == DeferredBucket)
+		{
+			Timer.Bucket = INDEX_NONE;
+			FreeTimer(DeferredCall.Index);
+		}
+		return true;
+	});
+}
+
+void FFlowTimerWheel::FlushThrottledTimers()
+{
+	// calls deferred by executed delegates will wait for the next flush
+	const TArray<FDeferredCall> Calls = MoveTemp(DeferredCalls);
+	DeferredCalls.Reset();
+
+	for (const FDeferredCall& DeferredCall : Calls)
+	{
+		ExecuteDeferredCall(DeferredCall);
+	}
+}
+
+void FFlowTimerWheel::Advance(const float DeltaSeconds)
+{
+	CurrentTime += FMath::Max(0.0f, DeltaSeconds);
+
+	FireBucket(NextTickBucket);
+
+	const uint64 TargetTick = static_cast<uint64>(FMath::FloorToDouble(CurrentTime / TickDuration));
+	if (NumActiveTimers == 0)
+	{
+		CurrentTick = FMath::Max(CurrentTick, TargetTick);
+		return;
+	}
+
+	while (CurrentTick < TargetTick)
+	{
+		CurrentTick++;
+
+		const int32 Level0Slot = static_cast<int32>(CurrentTick & (Level0Slots - 1));
+		if (Level0Slot == 0)
+		{
+			// move timers from upper levels closer to the current tick
+			uint64 LevelTick = CurrentTick >> Level0Bits;
+			for (int32 Level = 1; Level < NumLevels; Level++)
+			{
+				const int32 Slot = static_cast<int32>(LevelTick & (LevelSlots - 1));
+				Cascade(Level, Slot);
+
+				if (Slot != 0)
+				{
+					break;
+				}
+				LevelTick >>= LevelBits;
+			}
+		}
+
+		FireBucket(Level0Slot);
+	}
+}
+
+void FFlowTimerWheel::Reset()
+{
+	Timers.Empty();
+	FreeIndexes.Empty();
+	BucketHeads.Init(INDEX_NONE, NumBuckets);
+	OwnerTimeDilations.Empty();
+	ThrottledOwners.Empty();
+	DeferredCalls.Empty();
+
+	CurrentTime = 0.0;
+	CurrentTick = 0;
+	NumActiveTimers = 0;
+}
+
+FFlowTimerWheel::FTimer* FFlowTimerWheel::FindTimer(const FFlowTimerHandle& Handle)
+{
+	if (Timers.IsValidIndex(Handle.Index) && Timers[Handle.Index].bAllocated && Timers[Handle.Index].Serial == Handle.Serial)
+	{
+		return &Timers[Handle.Index];
+	}
+
+	return nullptr;
+}
+
+const FFlowTimerWheel::FTimer* FFlowTimerWheel::FindTimer(const FFlowTimerHandle& Handle) const
+{
+	return const_cast<FFlowTimerWheel*>(this)->FindTimer(Handle);
+}
+
+int32 FFlowTimerWheel::AllocateTimer()
+{
+	const int32 Index = FreeIndexes.Num() > 0 ? FreeIndexes.Pop() : Timers.AddDefaulted();
+
+	FTimer& Timer = Timers[Index];
+	Timer = FTimer();
+	Timer.bAllocated = true;
+
+	// serial 0 is never used, so default handle never matches any timer
+	Timer.Serial = ++NextSerial == 0 ? ++NextSerial : NextSerial;
+
+	NumActiveTimers++;
+	return Index;
+}
+
+void FFlowTimerWheel::FreeTimer(const int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.Delegate.Unbind();
+	Timer.bAllocated = false;
+
+	FreeIndexes.Add(Index);
+	NumActiveTimers--;
+}
+
+void FFlowTimerWheel::Schedule(const int32 Index, const float OwnerDelay, const float TimeDilation)
+{
+	FTimer& Timer = Timers[Index];
+
+	// timer is kept outside of the wheel until its owner is unpaused
+	if (TimeDilation <= 0.0f)
+	{
+		Timer.PausedRemaining = OwnerDelay;
+		return;
+	}
+
+	Timer.ExpireTime = CurrentTime + FMath::Max(0.0f, OwnerDelay) / TimeDilation;
+	Timer.ExpireTick = FMath::Max(CurrentTick + 1, static_cast<uint64>(FMath::CeilToDouble(Timer.ExpireTime / TickDuration)));
+	LinkToWheel(Index);
+}
+
+void FFlowTimerWheel::Link(const int32 Index, const int32 Bucket)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.Bucket = Bucket;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = BucketHeads[Bucket];
+
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Index;
+	}
+	BucketHeads[Bucket] = Index;
+}
+
+void FFlowTimerWheel::Unlink(const int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	if (Timer.Bucket == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Timer.Bucket == DeferredBucket)
+	{
+		Timer.Bucket = INDEX_NONE;
+		return;
+	}
+
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		BucketHeads[Timer.Bucket] = Timer.Next;
+	}
+
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+
+	Timer.Bucket = INDEX_NONE;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+}
+
+void FFlowTimerWheel::LinkToWheel(const int32 Index)
+{
+	const FTimer& Timer = Timers[Index];
+	const uint64 Delta = Timer.ExpireTick - CurrentTick;
+
+	if (Delta < Level0Slots)
+	{
+		Link(Index, static_cast<int32>(Timer.ExpireTick & (Level0Slots - 1)));
+		return;
+	}
+
+	int32 Level = 1;
+	int32 Shift = Level0Bits;
+	while (Level < NumLevels - 1 && Delta >= (1ull << (Shift + LevelBits)))
+	{
+		Level++;
+		Shift += LevelBits;
+	}
+
+	// timers beyond the wheel range are parked in the farthest slot and cascaded again later
+	uint64 SlotTick = Timer.ExpireTick;
+	if (Delta >= (1ull << (Shift + LevelBits)))
+	{
+		SlotTick = CurrentTick + (1ull << (Shift + LevelBits)) - 1;
+	}
+
+	const int32 Slot = static_cast<int32>((SlotTick >> Shift) & (LevelSlots - 1));
+	Link(Index, Level0Slots + (Level - 1) * LevelSlots + Slot);
+}
+
+void FFlowTimerWheel::Cascade(const int32 Level, const int32 Slot)
+{
+	const int32 Bucket = Level0Slots + (Level - 1) * LevelSlots + Slot;
+
+	int32 Index = BucketHeads[Bucket];
+	BucketHeads[Bucket] = INDEX_NONE;
+
+	while (Index != INDEX_NONE)
+	{
+		const int32 NextIndex = Timers[Index].Next;
+
+		Timers[Index].Bucket = INDEX_NONE;
+		Timers[Index].Prev = INDEX_NONE;
+		Timers[Index].Next = INDEX_NONE;
+		LinkToWheel(Index);
+
+		Index = NextIndex;
+	}
+}
+
+void FFlowTimerWheel::FireBucket(const int32 Bucket)
+{
+	if (BucketHeads[Bucket] == INDEX_NONE)
+	{
+		return;
+	}
+
+	// move timers to the separate list, so delegates can safely set or clear any timer
+	check(BucketHeads[FiringBucket] == INDEX_NONE);
+	BucketHeads[FiringBucket] = BucketHeads[Bucket];
+	BucketHeads[Bucket] = INDEX_NONE;
+	for (int32 Index = BucketHeads[FiringBucket]; Index != INDEX_NONE; Index = Timers[Index].Next)
+	{
+		Timers[Index].Bucket = FiringBucket;
+	}
+
+	while (BucketHeads[FiringBucket] != INDEX_NONE)
+	{
+		const int32 Index = BucketHeads[FiringBucket];
+		Unlink(Index);
+
+		FFlowTimerDelegate Delegate;
+		FTimer& Timer = Timers[Index];
+		const bool bDeferred = ThrottledOwners.Num() > 0 && ThrottledOwners.Contains(Timer.Owner);
+
+		if (Timer.bLoop)
+		{
+			if (!bDeferred)
+			{
+				Delegate = Timer.Delegate;
+			}
+
+			const float TimeDilation = GetTimeDilation(Timer.Owner);
+			Timer.CycleDuration = Timer.Rate;
+
+			if (TimeDilation <= 0.0f)
+			{
+				// owner paused by the timer fired earlier in this bucket, SetTimeDilation skipped this timer
+				// it's kept outside of the wheel, same as in Schedule
+				Timer.PausedRemaining = Timer.Rate;
+			}
+			else
+			{
+				// keep the original schedule, so frame times don't accumulate a drift
+				Timer.ExpireTime += Timer.Rate / TimeDilation;
+				Timer.ExpireTick = FMath::Max(CurrentTick + 1, static_cast<uint64>(FMath::CeilToDouble(Timer.ExpireTime / TickDuration)));
+				LinkToWheel(Index);
+			}
+		}
+		else if (bDeferred)
+		{
+			// timer stays allocated until the deferred call, so it can be still cleared
+			Timer.Bucket = DeferredBucket;
+		}
+		else
+		{
+			Delegate = MoveTemp(Timer.Delegate);
+			FreeTimer(Index);
+		}
+
+		if (bDeferred)
+		{
+			DeferredCalls.Add({Index, Timer.Serial});
+		}
+		else
+		{
+			Delegate.ExecuteIfBound();
+		}
+	}
+}
+
+void FFlowTimerWheel::ExecuteDeferredCall(const FDeferredCall& DeferredCall)
+{
+	FTimer& Timer = Timers[DeferredCall.Index];
+
+	// timer was cleared after deferring the call
+	if (!Timer.bAllocated || Timer.Serial != DeferredCall.Serial)
+	{
+		return;
+	}
+
+	FFlowTimerDelegate Delegate;
+	if (Timer.Bucket == DeferredBucket)
+	{
+		Delegate = MoveTemp(Timer.Delegate);
+		Timer.Bucket = INDEX_NONE;
+		FreeTimer(DeferredCall.Index);
+	}
+	else
+	{
+		Delegate = Timer.Delegate;
+	}
+
+	Delegate.ExecuteIfBound();
+}
+
+float FFlowTimerWheel::GetRemaining(const FTimer& Timer) const
+{
+	if (Timer.Bucket == INDEX_NONE)
+	{
+		return Timer.PausedRemaining;
+	}
+
+	if (Timer.Bucket == NextTickBucket || Timer.Bucket == FiringBucket || Timer.Bucket == DeferredBucket)
+	{
+		return 0.0f;
+	}
+
+	const float TimeDilation = GetTimeDilation(Timer.Owner);
+	return FMath::Max(0.0f, static_cast<float>(Timer.ExpireTime - CurrentTime) * TimeDilation);
+}
@@ -0,0 +1,9 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/FlowLightweightNode.h"
+#include "FlowAsset.h"
+
+void FFlowLightweightNodeContext::TriggerOutput(const FName& PinName) const
+{
+	FlowAsset.TriggerCompiledOutput(NodeIndex, PinName);
+}
@@ -8,6 +8,7 @@
 #include "FlowSettings.h"
 #include "FlowSubsystem.h"
 #include "FlowTypes.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
 
 #include "Components/ActorComponent.h"
 #include "Engine/Blueprint.h"
@@ -34,6 +35,8 @@ FString UFlowNode::MissingNotifyTag = TEXT("Missing Notify Tag");
 FString UFlowNode::MissingClass = TEXT("Missing class");
 FString UFlowNode::NoActorsFound = TEXT("No actors found");
 
+TMap<TObjectKey<UClass>, EFlowNodeBlueprintEvent> UFlowNode::ImplementedBlueprintEventsPerClass;
+
 UFlowNode::UFlowNode(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, GraphNode(nullptr)
@@ -46,6 +49,8 @@ UFlowNode::UFlowNode(const FObjectInitializer& ObjectInitializer)
 	, SignalMode(EFlowSignalMode::Enabled)
 	, bPreloaded(false)
 	, ActivationState(EFlowNodeState::NeverActivated)
+	, ImplementedBlueprintEvents(EFlowNodeBlueprintEvent::All)
+	, CompiledIndex(INDEX_NONE)
 {
 #if WITH_EDITOR
 	Category = TEXT("Uncategorized");
@@ -158,27 +163,13 @@ UFlowAsset* UFlowNode::GetFlowAsset() const
 
 AActor* UFlowNode::TryGetRootFlowActorOwner() const
 {
-	AActor* OwningActor = nullptr;
-
-	UObject* RootFlowOwner = TryGetRootFlowObjectOwner();
-
-	if (IsValid(RootFlowOwner))
+	const UFlowAsset* FlowAsset = GetFlowAsset();
+	if (!IsValid(FlowAsset))
 	{
-		// Check if the immediate parent is an AActor
-		OwningActor = Cast<AActor>(RootFlowOwner);
-
-		if (!IsValid(OwningActor))
-		{
-			// Check if the if the immediate parent is an UActorComponent
-			//  and return that Component's Owning actor
-			if (const UActorComponent* OwningComponent = Cast<UActorComponent>(RootFlowOwner))
-			{
-				OwningActor = OwningComponent->GetOwner();
-			}
-		}
+		return nullptr;
 	}
 
-	return OwningActor;
+	return FlowAsset->IsOwnerContextCached() ? FlowAsset->CachedActorOwner.Get() : TryGetActorOwner(FlowAsset->GetOwner());
 }
 
 UObject* UFlowNode::TryGetRootFlowObjectOwner() const
@@ -201,13 +192,39 @@ IFlowOwnerInterface* UFlowNode::GetFlowOwnerInterface() const
 		return nullptr;
 	}
 
-	const UClass* ExpectedOwnerClass = FlowAsset->GetExpectedOwnerClass();
+	return FlowAsset->IsOwnerContextCached() ? FlowAsset->CachedFlowOwnerInterface.Get() : TryGetFlowOwnerInterface(FlowAsset->GetOwner(), FlowAsset->GetExpectedOwnerClass());
+}
+
+AActor* UFlowNode::TryGetActorOwner(UObject* RootFlowOwner)
+{
+	AActor* OwningActor = nullptr;
+
+	if (IsValid(RootFlowOwner))
+	{
+		// Check if the immediate parent is an AActor
+		OwningActor = Cast<AActor>(RootFlowOwner);
+
+		if (!IsValid(OwningActor))
+		{
+			// Check if the if the immediate parent is an UActorComponent
+			//  and return that Component's Owning actor
+			if (const UActorComponent* OwningComponent = Cast<UActorComponent>(RootFlowOwner))
+			{
+				OwningActor = OwningComponent->GetOwner();
+			}
+		}
+	}
+
+	return OwningActor;
+}
+
+IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterface(UObject* RootFlowOwner, const UClass* ExpectedOwnerClass)
+{
 	if (!IsValid(ExpectedOwnerClass))
 	{
 		return nullptr;
 	}
 
-	UObject* RootFlowOwner = FlowAsset->GetOwner();
 	if (!IsValid(RootFlowOwner))
 	{
 		return nullptr;
@@ -226,7 +243,7 @@ IFlowOwnerInterface* UFlowNode::GetFlowOwnerInterface() const
 	return nullptr;
 }
 
-IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterfaceFromRootFlowOwner(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass) const
+IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterfaceFromRootFlowOwner(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass)
 {
 	const UClass* RootFlowOwnerClass = RootFlowOwner.GetClass();
 	if (!IsValid(RootFlowOwnerClass))
@@ -243,7 +260,7 @@ IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterfaceFromRootFlowOwner(UObjec
 	return CastChecked<IFlowOwnerInterface>(&RootFlowOwner);
 }
 
-IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterfaceActor(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass) const
+IFlowOwnerInterface* UFlowNode::TryGetFlowOwnerInterfaceActor(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass)
 {
 	// Special case if the immediate owner is a component, also consider the component's owning actor
 	const UActorComponent* FlowComponent = Cast<UActorComponent>(&RootFlowOwner);
@@ -423,18 +440,104 @@ void UFlowNode::RemoveUserOutput(const FName& PinName)
 }
 #endif
 
+const FFlowCompiledGraph* UFlowNode::FindCompiledConnections(int32& OutNodeIndex) const
+{
+	const UFlowAsset* FlowAsset = GetFlowAsset();
+	if (FlowAsset == nullptr || !FlowAsset->AreNodeConnectionsStripped())
+	{
+		return nullptr;
+	}
+
+	const FFlowCompiledGraph& CompiledGraph = FlowAsset->GetCompiledGraph();
+	OutNodeIndex = CompiledIndex != INDEX_NONE ? CompiledIndex : CompiledGraph.Nodes.IndexOfByPredicate([this](const FFlowCompiledNode& CompiledNode)
+	{
+		return CompiledNode.NodeGuid == NodeGuid;
+	});
+
+	return OutNodeIndex != INDEX_NONE ? &CompiledGraph : nullptr;
+}
+
+FConnectedPin UFlowNode::GetConnection(const FName OutputName) const
+{
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		const FFlowCompiledEdge* Edge = CompiledGraph->FindEdge(NodeIndex, OutputName);
+		return Edge ? FConnectedPin(CompiledGraph->Nodes[Edge->TargetNode].NodeGuid, Edge->TargetPinName) : FConnectedPin();
+	}
+
+	return Connections.FindRef(OutputName);
+}
+
+void UFlowNode::GetConnections(const FName& OutputName, TArray<FConnectedPin>& OutConnections) const
+{
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		for (const FFlowCompiledEdge& Edge : CompiledGraph->FindEdges(NodeIndex, OutputName))
+		{
+			OutConnections.Emplace(CompiledGraph->Nodes[Edge.TargetNode].NodeGuid, Edge.TargetPinName);
+		}
+		return;
+	}
+
+	if (const FConnectedPin* Connection = Connections.Find(OutputName))
+	{
+		OutConnections.Add(*Connection);
+
+		if (const FConnectedPins* FanOutConnection = FanOutConnections.Find(OutputName))
+		{
+			OutConnections.Append(FanOutConnection->Pins);
+		}
+	}
+}
+
 TSet<UFlowNode*> UFlowNode::GetConnectedNodes() const
 {
 	TSet<UFlowNode*> Result;
+
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		const FFlowCompiledNode& CompiledNode = CompiledGraph->Nodes[NodeIndex];
+		for (int32 EdgeIndex = CompiledNode.FirstEdge; EdgeIndex < CompiledNode.FirstEdge + CompiledNode.NumEdges; EdgeIndex++)
+		{
+			Result.Emplace(GetFlowAsset()->GetNode(CompiledGraph->Nodes[CompiledGraph->Edges[EdgeIndex].TargetNode].NodeGuid));
+		}
+		return Result;
+	}
+
 	for (const TPair<FName, FConnectedPin>& Connection : Connections)
 	{
 		Result.Emplace(GetFlowAsset()->GetNode(Connection.Value.NodeGuid));
 	}
+	for (const TPair<FName, FConnectedPins>& FanOutConnection : FanOutConnections)
+	{
+		for (const FConnectedPin& Connection : FanOutConnection.Value.Pins)
+		{
+			Result.Emplace(GetFlowAsset()->GetNode(Connection.NodeGuid));
+		}
+	}
 	return Result;
 }
 
 FName UFlowNode::GetPinConnectedToNode(const FGuid& OtherNodeGuid)
 {
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		const FFlowCompiledNode& CompiledNode = CompiledGraph->Nodes[NodeIndex];
+		for (int32 EdgeIndex = CompiledNode.FirstEdge; EdgeIndex < CompiledNode.FirstEdge + CompiledNode.NumEdges; EdgeIndex++)
+		{
+			const FFlowCompiledEdge& Edge = CompiledGraph->Edges[EdgeIndex];
+			if (CompiledGraph->Nodes[Edge.TargetNode].NodeGuid == OtherNodeGuid)
+			{
+				return Edge.OutputPinName;
+			}
+		}
+		return NAME_None;
+	}
+
 	for (const TPair<FName, FConnectedPin>& Connection : Connections)
 	{
 		if (Connection.Value.NodeGuid == OtherNodeGuid)
@@ -443,11 +546,31 @@ FName UFlowNode::GetPinConnectedToNode(const FGuid& OtherNodeGuid)
 		}
 	}
 
+	for (const TPair<FName, FConnectedPins>& FanOutConnection : FanOutConnections)
+	{
+		for (const FConnectedPin& Connection : FanOutConnection.Value.Pins)
+		{
+			if (Connection.NodeGuid == OtherNodeGuid)
+			{
+				return FanOutConnection.Key;
+			}
+		}
+	}
+
 	return NAME_None;
 }
 
 bool UFlowNode::IsInputConnected(const FName& PinName) const
 {
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		return CompiledGraph->Edges.ContainsByPredicate([NodeIndex, &PinName](const FFlowCompiledEdge& Edge)
+		{
+			return Edge.TargetNode == NodeIndex && Edge.TargetPinName == PinName;
+		});
+	}
+
 	if (GetFlowAsset())
 	{
 		for (const TPair<FGuid, UFlowNode*>& Pair : GetFlowAsset()->Nodes)
@@ -461,6 +584,14 @@ bool UFlowNode::IsInputConnected(const FName& PinName) const
 						return true;
 					}
 				}
+
+				for (const TPair<FName, FConnectedPins>& FanOutConnection : Pair.Value->FanOutConnections)
+				{
+					if (FanOutConnection.Value.Pins.Contains(FConnectedPin(NodeGuid, PinName)))
+					{
+						return true;
+					}
+				}
 			}
 		}
 	}
@@ -470,7 +601,18 @@ bool UFlowNode::IsInputConnected(const FName& PinName) const
 
 bool UFlowNode::IsOutputConnected(const FName& PinName) const
 {
-	return OutputPins.Contains(PinName) && Connections.Contains(PinName);
+	if (!OutputPins.Contains(PinName))
+	{
+		return false;
+	}
+
+	int32 NodeIndex;
+	if (const FFlowCompiledGraph* CompiledGraph = FindCompiledConnections(NodeIndex))
+	{
+		return CompiledGraph->FindEdge(NodeIndex, PinName) != nullptr;
+	}
+
+	return Connections.Contains(PinName);
 }
 
 void UFlowNode::RecursiveFindNodesByClass(UFlowNode* Node, const TSubclassOf<UFlowNode> Class, uint8 Depth, TArray<UFlowNode*>& OutNodes)
@@ -503,9 +645,15 @@ UFlowSubsystem* UFlowNode::GetFlowSubsystem() const
 
 UWorld* UFlowNode::GetWorld() const
 {
-	if (GetFlowAsset() && GetFlowAsset()->GetFlowSubsystem())
+	const UFlowAsset* FlowAsset = GetFlowAsset();
+	if (FlowAsset && FlowAsset->IsOwnerContextCached() && FlowAsset->CachedWorld.IsValid())
+	{
+		return FlowAsset->CachedWorld.Get();
+	}
+
+	if (FlowAsset && FlowAsset->GetFlowSubsystem())
 	{
-		return GetFlowAsset()->GetFlowSubsystem()->GetWorld();
+		return FlowAsset->GetFlowSubsystem()->GetWorld();
 	}
 
 	return nullptr;
@@ -513,7 +661,51 @@ UWorld* UFlowNode::GetWorld() const
 
 void UFlowNode::InitializeInstance()
 {
-	K2_InitializeInstance();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::InitializeInstance))
+	{
+		K2_InitializeInstance();
+	}
+}
+
+void UFlowNode::CacheImplementedBlueprintEvents()
+{
+	UClass* NodeClass = GetClass();
+	if (const EFlowNodeBlueprintEvent* CachedEvents = ImplementedBlueprintEventsPerClass.Find(NodeClass))
+	{
+		ImplementedBlueprintEvents = *CachedEvents;
+		return;
+	}
+
+	const TPair<EFlowNodeBlueprintEvent, FName> Events[] = {
+		{EFlowNodeBlueprintEvent::InitializeInstance, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_InitializeInstance)},
+		{EFlowNodeBlueprintEvent::PreloadContent, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_PreloadContent)},
+		{EFlowNodeBlueprintEvent::FlushContent, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_FlushContent)},
+		{EFlowNodeBlueprintEvent::OnActivate, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_OnActivate)},
+		{EFlowNodeBlueprintEvent::ExecuteInput, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_ExecuteInput)},
+		{EFlowNodeBlueprintEvent::Cleanup, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_Cleanup)},
+		{EFlowNodeBlueprintEvent::DeinitializeInstance, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_DeinitializeInstance)},
+		{EFlowNodeBlueprintEvent::ForceFinishNode, GET_FUNCTION_NAME_CHECKED(UFlowNode, K2_ForceFinishNode)},
+		{EFlowNodeBlueprintEvent::OnSave, GET_FUNCTION_NAME_CHECKED(UFlowNode, OnSave)},
+		{EFlowNodeBlueprintEvent::OnLoad, GET_FUNCTION_NAME_CHECKED(UFlowNode, OnLoad)},
+		{EFlowNodeBlueprintEvent::OnPassThrough, GET_FUNCTION_NAME_CHECKED(UFlowNode, OnPassThrough)}
+	};
+
+	// native classes never implement events in script, Blueprint classes only implement events they override
+	ImplementedBlueprintEvents = EFlowNodeBlueprintEvent::None;
+	for (const TPair<EFlowNodeBlueprintEvent, FName>& Event : Events)
+	{
+		if (NodeClass->IsFunctionImplementedInScript(Event.Value))
+		{
+			ImplementedBlueprintEvents |= Event.Key;
+		}
+	}
+
+	ImplementedBlueprintEventsPerClass.Add(NodeClass, ImplementedBlueprintEvents);
+}
+
+void UFlowNode::ResetImplementedBlueprintEvents()
+{
+	ImplementedBlueprintEventsPerClass.Empty();
 }
 
 void UFlowNode::TriggerPreload()
@@ -530,17 +722,26 @@ void UFlowNode::TriggerFlush()
 
 void UFlowNode::PreloadContent()
 {
-	K2_PreloadContent();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::PreloadContent))
+	{
+		K2_PreloadContent();
+	}
 }
 
 void UFlowNode::FlushContent()
 {
-	K2_FlushContent();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::FlushContent))
+	{
+		K2_FlushContent();
+	}
 }
 
 void UFlowNode::OnActivate()
 {
-	K2_OnActivate();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::OnActivate))
+	{
+		K2_OnActivate();
+	}
 }
 
 void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType ActivationType /*= Default*/)
@@ -600,7 +801,14 @@ void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType
 			{
 				LogNote(FString::Printf(TEXT("Signal pass-through on triggering input %s"), *PinName.ToString()));
 			}
-			OnPassThrough();
+			if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::OnPassThrough))
+			{
+				OnPassThrough();
+			}
+			else
+			{
+				OnPassThrough_Implementation();
+			}
 			break;
 		default: ;
 	}
@@ -608,7 +816,10 @@ void UFlowNode::TriggerInput(const FName& PinName, const EFlowPinActivationType
 
 void UFlowNode::ExecuteInput(const FName& PinName)
 {
-	K2_ExecuteInput(PinName);
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::ExecuteInput))
+	{
+		K2_ExecuteInput(PinName);
+	}
 }
 
 void UFlowNode::TriggerFirstOutput(const bool bFinish)
@@ -620,6 +831,16 @@ void UFlowNode::TriggerFirstOutput(const bool bFinish)
 }
 
 void UFlowNode::TriggerOutput(const FName& PinName, const bool bFinish /*= false*/, const EFlowPinActivationType ActivationType /*= Default*/)
+{
+	TriggerOutput_Internal(PinName, bFinish, ActivationType, nullptr);
+}
+
+void UFlowNode::TriggerOutputExcludingNodes(const FName& PinName, const TSet<FGuid>& ExcludedNodes)
+{
+	TriggerOutput_Internal(PinName, false, EFlowPinActivationType::Default, &ExcludedNodes);
+}
+
+void UFlowNode::TriggerOutput_Internal(const FName& PinName, const bool bFinish, const EFlowPinActivationType ActivationType, const TSet<FGuid>* ExcludedNodes)
 {
 	// clean up node, if needed
 	if (bFinish)
@@ -648,10 +869,22 @@ void UFlowNode::TriggerOutput(const FName& PinName, const bool bFinish /*= false
 #endif // UE_BUILD_SHIPPING
 
 	// call the next node
-	if (OutputPins.Contains(PinName) && Connections.Contains(PinName))
+	if (CompiledIndex != INDEX_NONE)
+	{
+		GetFlowAsset()->TriggerCompiledOutput(CompiledIndex, PinName, ExcludedNodes);
+	}
+	else if (OutputPins.Contains(PinName))
 	{
-		const FConnectedPin FlowPin = GetConnection(PinName);
-		GetFlowAsset()->TriggerInput(FlowPin.NodeGuid, FlowPin.PinName);
+		TArray<FConnectedPin> OutputConnections;
+		GetConnections(PinName, OutputConnections);
+
+		for (const FConnectedPin& Connection : OutputConnections)
+		{
+			if (ExcludedNodes == nullptr || !ExcludedNodes->Contains(Connection.NodeGuid))
+			{
+				GetFlowAsset()->TriggerInput(Connection.NodeGuid, Connection.PinName);
+			}
+		}
 	}
 }
 
@@ -697,17 +930,26 @@ void UFlowNode::Deactivate()
 
 void UFlowNode::Cleanup()
 {
-	K2_Cleanup();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::Cleanup))
+	{
+		K2_Cleanup();
+	}
 }
 
 void UFlowNode::DeinitializeInstance()
 {
-	K2_DeinitializeInstance();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::DeinitializeInstance))
+	{
+		K2_DeinitializeInstance();
+	}
 }
 
 void UFlowNode::ForceFinishNode()
 {
-	K2_ForceFinishNode();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::ForceFinishNode))
+	{
+		K2_ForceFinishNode();
+	}
 }
 
 void UFlowNode::ResetRecords()
@@ -723,7 +965,14 @@ void UFlowNode::ResetRecords()
 void UFlowNode::SaveInstance(FFlowNodeSaveData& NodeRecord)
 {
 	NodeRecord.NodeGuid = NodeGuid;
-	OnSave();
+	if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::OnSave))
+	{
+		OnSave();
+	}
+	else
+	{
+		OnSave_Implementation();
+	}
 
 	FMemoryWriter MemoryWriter(NodeRecord.NodeData, true);
 	FFlowArchive Ar(MemoryWriter);
@@ -744,7 +993,14 @@ void UFlowNode::LoadInstance(const FFlowNodeSaveData& NodeRecord)
 	switch (SignalMode)
 	{
 		case EFlowSignalMode::Enabled:
-			OnLoad();
+			if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::OnLoad))
+			{
+				OnLoad();
+			}
+			else
+			{
+				OnLoad_Implementation();
+			}
 			break;
 		case EFlowSignalMode::Disabled:
 			// designer doesn't want to execute this node's logic at all, so we kill it
@@ -753,7 +1009,14 @@ void UFlowNode::LoadInstance(const FFlowNodeSaveData& NodeRecord)
 			break;
 		case EFlowSignalMode::PassThrough:
 			LogNote(TEXT("Signal pass-through on loading Flow Node from SaveGame"));
-			OnPassThrough();
+			if (IsBlueprintEventImplemented(EFlowNodeBlueprintEvent::OnPassThrough))
+			{
+				OnPassThrough();
+			}
+			else
+			{
+				OnPassThrough_Implementation();
+			}
 			break;
 		default: ;
 	}
@@ -773,7 +1036,7 @@ void UFlowNode::OnPassThrough_Implementation()
 	// pin connections aren't serialized to the SaveGame, so users can safely change connections post game release
 	for (const FFlowPin& OutputPin : OutputPins)
 	{
-		if (Connections.Contains(OutputPin.PinName))
+		if (IsOutputConnected(OutputPin.PinName))
 		{
 			TriggerOutput(OutputPin.PinName, false, EFlowPinActivationType::PassThrough);
 		}
@@ -944,6 +1207,15 @@ bool UFlowNode::BuildMessage(FString& Message) const
 	{
 		const FString TemplatePath = GetFlowAsset()->TemplateAsset->GetPathName();
 		Message.Append(TEXT(" --- node ")).Append(GetName()).Append(TEXT(", asset ")).Append(FPaths::GetPath(TemplatePath) / FPaths::GetBaseFilename(TemplatePath));
+
+		// node copied from the Sub Graph asset while cooking, its guid identifies the node in the Sub Graph asset
+		const FFlowInlinedNode* InlinedNode = GetFlowAsset()->FindInlinedNode(GetGuid());
+		if (const UFlowNode_SubGraph* InlinedSubGraphNode = InlinedNode ? GetFlowAsset()->GetInlinedSubGraphNode(this) : nullptr)
+		{
+			Message.Append(TEXT(", inlined from ")).Append(InlinedSubGraphNode->GetAssetPath().GetLongPackageName());
+			Message.Append(TEXT(", source node ")).Append(InlinedNode->SourceNodeGuid.ToString());
+		}
+
 		return true;
 	}
 
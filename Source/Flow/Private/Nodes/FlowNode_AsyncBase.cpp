@@ -0,0 +1,81 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/FlowNode_AsyncBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_AsyncBase)
+
+UFlowNode_AsyncBase::UFlowNode_AsyncBase(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bAsyncWorkPending(false)
+	, PendingWorkSerial(0)
+	, LastWorkSerial(0)
+{
+}
+
+void UFlowNode_AsyncBase::CancelAsyncWork()
+{
+	bAsyncWorkPending = false;
+	AsyncWorkInputPin = NAME_None;
+	PendingWorkSerial = 0;
+}
+
+void UFlowNode_AsyncBase::RestartAsyncWork()
+{
+	// SaveGame written before recording the input has no pin
+	const FName InputPin = AsyncWorkInputPin.IsNone() ? DefaultInputPin.PinName : AsyncWorkInputPin;
+	AsyncWorkInputPin = NAME_None;
+
+	ExecuteInput(InputPin);
+}
+
+void UFlowNode_AsyncBase::Cleanup()
+{
+	CancelAsyncWork();
+
+	Super::Cleanup();
+}
+
+void UFlowNode_AsyncBase::OnLoad_Implementation()
+{
+	Super::OnLoad_Implementation();
+
+	if (bAsyncWorkPending)
+	{
+		bAsyncWorkPending = false;
+		RestartAsyncWork();
+	}
+}
+
+uint32 UFlowNode_AsyncBase::StartAsyncWork(const FName& InputPin)
+{
+	check(IsInGameThread());
+
+	// zero is reserved for no pending work
+	LastWorkSerial = LastWorkSerial == MAX_uint32 ? 1 : LastWorkSerial + 1;
+
+	PendingWorkSerial = LastWorkSerial;
+	bAsyncWorkPending = true;
+	AsyncWorkInputPin = InputPin;
+
+	return PendingWorkSerial;
+}
+
+bool UFlowNode_AsyncBase::CompleteAsyncWork(const uint32 WorkSerial)
+{
+	if (!bAsyncWorkPending || WorkSerial != PendingWorkSerial)
+	{
+		return false;
+	}
+
+	bAsyncWorkPending = false;
+	AsyncWorkInputPin = NAME_None;
+	PendingWorkSerial = 0;
+	return true;
+}
+
+#if WITH_EDITOR
+FString UFlowNode_AsyncBase::GetStatusString() const
+{
+	return bAsyncWorkPending ? TEXT("Waiting for async work") : FString();
+}
+#endif
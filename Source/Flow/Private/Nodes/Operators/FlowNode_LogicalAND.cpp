@@ -1,11 +1,13 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Operators/FlowNode_LogicalAND.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_LogicalAND)
 
 UFlowNode_LogicalAND::UFlowNode_LogicalAND(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, ExecutedInputs(0)
 {
 #if WITH_EDITOR
 	Category = TEXT("Operators");
@@ -17,15 +19,81 @@ UFlowNode_LogicalAND::UFlowNode_LogicalAND(const FObjectInitializer& ObjectIniti
 
 void UFlowNode_LogicalAND::ExecuteInput(const FName& PinName)
 {
-	ExecutedInputNames.Add(PinName);
+	const int32 PinIndex = InputPins.IndexOfByKey(PinName);
+	if (PinIndex == INDEX_NONE || PinIndex >= MaxInputs)
+	{
+		return;
+	}
+
+	ExecutedInputs |= 1ull << PinIndex;
 
-	if (ExecutedInputNames.Num() == InputPins.Num())
+	if (ExecutedInputs == GetAllInputsMask())
 	{
 		TriggerFirstOutput(true);
 	}
 }
 
-void UFlowNode_LogicalAND::Cleanup()
+void UFlowNode_LogicalAND::OnLoad_Implementation()
 {
+	for (const FName& PinName : ExecutedInputNames)
+	{
+		const int32 PinIndex = InputPins.IndexOfByKey(PinName);
+		if (PinIndex != INDEX_NONE && PinIndex < MaxInputs)
+		{
+			ExecutedInputs |= 1ull << PinIndex;
+		}
+	}
+
 	ExecutedInputNames.Empty();
 }
+
+void UFlowNode_LogicalAND::Cleanup()
+{
+	ExecutedInputs = 0;
+}
+
+uint64 UFlowNode_LogicalAND::GetAllInputsMask() const
+{
+	return InputPins.Num() >= MaxInputs ? MAX_uint64 : (1ull << InputPins.Num()) - 1;
+}
+
+int32 UFlowNode_LogicalAND::GetLightweightStateSize() const
+{
+	// executed inputs stored as bits of a single value
+	return InputPins.Num() <= 32 ? 1 : INDEX_NONE;
+}
+
+void UFlowNode_LogicalAND::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	const int32 PinIndex = InputPins.IndexOfByKey(PinName);
+	if (PinIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	uint32& StateExecutedInputs = reinterpret_cast<uint32&>(Context.State[0]);
+	StateExecutedInputs |= 1u << PinIndex;
+
+	if (FMath::CountBits(StateExecutedInputs) == InputPins.Num())
+	{
+		StateExecutedInputs = 0;
+
+		if (OutputPins.Num() > 0)
+		{
+			Context.TriggerOutput(OutputPins[0].PinName);
+		}
+	}
+}
+
+#if WITH_EDITOR
+EDataValidationResult UFlowNode_LogicalAND::ValidateNode()
+{
+	if (InputPins.Num() > MaxInputs)
+	{
+		ValidationLog.Error<UFlowNode>(*FString::Printf(TEXT("AND supports up to %d inputs"), MaxInputs), this);
+		return EDataValidationResult::Invalid;
+	}
+
+	return EDataValidationResult::Valid;
+}
+#endif
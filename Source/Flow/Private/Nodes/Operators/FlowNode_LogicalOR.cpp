@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Operators/FlowNode_LogicalOR.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_LogicalOR)
 
@@ -63,3 +64,58 @@ void UFlowNode_LogicalOR::ResetCounter()
 {
 	ExecutionCount = 0;
 }
+
+int32 UFlowNode_LogicalOR::GetLightweightStateSize() const
+{
+	// enabled flag and execution count
+	return 2;
+}
+
+void UFlowNode_LogicalOR::InitializeLightweightState(const TArrayView<int32> State) const
+{
+	State[0] = bEnabled;
+}
+
+void UFlowNode_LogicalOR::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	int32& StateEnabled = Context.State[0];
+	int32& StateExecutionCount = Context.State[1];
+
+	if (PinName == TEXT("Enable"))
+	{
+		if (!StateEnabled)
+		{
+			StateExecutionCount = 0;
+			StateEnabled = true;
+		}
+		return;
+	}
+
+	if (PinName == TEXT("Disable"))
+	{
+		if (StateEnabled)
+		{
+			StateEnabled = false;
+			StateExecutionCount = 0;
+		}
+		return;
+	}
+
+	// remaining inputs are numbered pins
+	if (StateEnabled)
+	{
+		StateExecutionCount++;
+		if (ExecutionLimit > 0 && StateExecutionCount == ExecutionLimit)
+		{
+			StateEnabled = false;
+		}
+
+		// node instance would reset counter while finishing
+		StateExecutionCount = 0;
+
+		if (OutputPins.Num() > 0)
+		{
+			Context.TriggerOutput(OutputPins[0].PinName);
+		}
+	}
+}
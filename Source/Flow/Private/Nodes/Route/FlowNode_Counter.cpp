@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_Counter.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Counter)
 
@@ -67,6 +68,51 @@ void UFlowNode_Counter::Cleanup()
 	CurrentSum = 0;
 }
 
+int32 UFlowNode_Counter::GetLightweightStateSize() const
+{
+	return 1;
+}
+
+void UFlowNode_Counter::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	int32& StateSum = Context.State[0];
+
+	if (PinName == TEXT("Increment"))
+	{
+		StateSum++;
+		if (StateSum == Goal)
+		{
+			StateSum = 0;
+			Context.TriggerOutput(TEXT("Goal"));
+		}
+		else
+		{
+			Context.TriggerOutput(TEXT("Step"));
+		}
+		return;
+	}
+
+	if (PinName == TEXT("Decrement"))
+	{
+		StateSum--;
+		if (StateSum == 0)
+		{
+			Context.TriggerOutput(TEXT("Zero"));
+		}
+		else
+		{
+			Context.TriggerOutput(TEXT("Step"));
+		}
+		return;
+	}
+
+	if (PinName == TEXT("Skip"))
+	{
+		StateSum = 0;
+		Context.TriggerOutput(TEXT("Skipped"));
+	}
+}
+
 #if WITH_EDITOR
 FString UFlowNode_Counter::GetNodeDescription() const
 {
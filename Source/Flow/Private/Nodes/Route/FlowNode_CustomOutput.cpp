@@ -19,6 +19,12 @@ void UFlowNode_CustomOutput::ExecuteInput(const FName& PinName)
 	UFlowAsset* FlowAsset = GetFlowAsset();
 	check(IsValid(FlowAsset));
 
+	if (FlowAsset->IsInlinedNode(this))
+	{
+		FlowAsset->TriggerInlinedCustomOutput(this, EventName);
+		return;
+	}
+
 	if (EventName.IsNone())
 	{
 		LogWarning(FString::Printf(TEXT("Attempted to trigger a CustomOutput (Node %s, Asset %s), with no EventName"),
@@ -1,12 +1,15 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_ExecutionMultiGate.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ExecutionMultiGate)
 
 UFlowNode_ExecutionMultiGate::UFlowNode_ExecutionMultiGate(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, StartIndex(INDEX_NONE)
+	, NextOutput(0)
+	, CompletedOutputs(0)
 {
 #if WITH_EDITOR
 	Category = TEXT("Route");
@@ -26,44 +29,28 @@ void UFlowNode_ExecutionMultiGate::ExecuteInput(const FName& PinName)
 {
 	if (PinName == DefaultInputPin.PinName)
 	{
-		if (Completed.Num() == 0)
-		{
-			Completed.Init(false, OutputPins.Num());
-		}
+		const int32 NumOutputs = FMath::Min(OutputPins.Num(), MaxOutputs);
+		const uint64 AllCompleted = NumOutputs == MaxOutputs ? MAX_uint64 : (1ull << NumOutputs) - 1;
 
-		if (!Completed.Contains(false))
+		if (CompletedOutputs == AllCompleted)
 		{
 			return;
 		}
 
-		const bool bUseStartIndex = !Completed.Contains(true) && Completed.IsValidIndex(StartIndex);
+		const bool bUseStartIndex = CompletedOutputs == 0 && StartIndex >= 0 && StartIndex < NumOutputs;
 
+		int32 Index;
 		if (bRandom)
 		{
-			int32 Index;
 			if (bUseStartIndex)
 			{
 				Index = StartIndex;
 			}
 			else
 			{
-				TArray<int32> AvailableIndexes;
-				AvailableIndexes.Reserve(Completed.Num()); // todo
-
-				for (int32 i = 0; i < Completed.Num(); i++)
-				{
-					if (Completed[i] == false)
-					{
-						AvailableIndexes.Emplace(i);
-					}
-				}
-
-				const int32 Random = FMath::RandRange(0, AvailableIndexes.Num() - 1);
-				Index = AvailableIndexes[Random];
+				const int32 Random = FMath::RandRange(0, NumOutputs - FMath::CountBits(CompletedOutputs) - 1);
+				Index = FindNthAvailableOutput(~CompletedOutputs & AllCompleted, Random);
 			}
-
-			Completed[Index] = true;
-			TriggerOutput(OutputPins[Index].PinName, false);
 		}
 		else
 		{
@@ -72,16 +59,16 @@ void UFlowNode_ExecutionMultiGate::ExecuteInput(const FName& PinName)
 				NextOutput = StartIndex;
 			}
 
-			const int32 CurrentOutput = NextOutput;
+			Index = NextOutput;
 			// We have to calculate NextOutput before TriggerOutput(..)
 			// TriggerOutput may call Reset and Cleanup
-			NextOutput = ++NextOutput % OutputPins.Num();
-
-			Completed[CurrentOutput] = true;
-			TriggerOutput(OutputPins[CurrentOutput].PinName, false);
+			NextOutput = (NextOutput + 1) % NumOutputs;
 		}
 
-		if (!Completed.Contains(false) && bLoop)
+		CompletedOutputs |= 1ull << Index;
+		TriggerOutput(OutputPins[Index].PinName, false);
+
+		if (CompletedOutputs == AllCompleted && bLoop)
 		{
 			Finish();
 		}
@@ -92,13 +79,118 @@ void UFlowNode_ExecutionMultiGate::ExecuteInput(const FName& PinName)
 	}
 }
 
+void UFlowNode_ExecutionMultiGate::OnLoad_Implementation()
+{
+	for (int32 Index = 0; Index < FMath::Min(Completed.Num(), MaxOutputs); Index++)
+	{
+		if (Completed[Index])
+		{
+			CompletedOutputs |= 1ull << Index;
+		}
+	}
+
+	Completed.Empty();
+}
+
 void UFlowNode_ExecutionMultiGate::Cleanup()
 {
 	NextOutput = 0;
-	Completed.Reset();
+	CompletedOutputs = 0;
+}
+
+int32 UFlowNode_ExecutionMultiGate::FindNthAvailableOutput(uint64 AvailableOutputs, int32 N)
+{
+	// binary search on bit counts of the lower half, so it takes 6 steps regardless of N
+	int32 Index = 0;
+	for (int32 Width = 32; Width > 0; Width >>= 1)
+	{
+		const int32 NumLower = static_cast<int32>(FMath::CountBits(AvailableOutputs & ((1ull << Width) - 1)));
+		if (N >= NumLower)
+		{
+			N -= NumLower;
+			AvailableOutputs >>= Width;
+			Index += Width;
+		}
+	}
+
+	return Index;
+}
+
+int32 UFlowNode_ExecutionMultiGate::GetLightweightStateSize() const
+{
+	// next output and completed outputs stored as bits of a single state value
+	return OutputPins.Num() <= MaxLightweightOutputs ? 2 : INDEX_NONE;
+}
+
+void UFlowNode_ExecutionMultiGate::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	int32& StateNextOutput = Context.State[0];
+	uint32& StateCompleted = reinterpret_cast<uint32&>(Context.State[1]);
+
+	if (PinName == DefaultInputPin.PinName)
+	{
+		const int32 NumOutputs = OutputPins.Num();
+		const uint32 AllCompleted = NumOutputs == MaxLightweightOutputs ? MAX_uint32 : (1u << NumOutputs) - 1;
+
+		if (StateCompleted == AllCompleted)
+		{
+			return;
+		}
+
+		const bool bUseStartIndex = StateCompleted == 0 && OutputPins.IsValidIndex(StartIndex);
+
+		int32 Index;
+		if (bRandom)
+		{
+			if (bUseStartIndex)
+			{
+				Index = StartIndex;
+			}
+			else
+			{
+				const int32 Random = FMath::RandRange(0, NumOutputs - FMath::CountBits(StateCompleted) - 1);
+				Index = FindNthAvailableOutput(~StateCompleted & AllCompleted, Random);
+			}
+		}
+		else
+		{
+			if (bUseStartIndex)
+			{
+				StateNextOutput = StartIndex;
+			}
+
+			Index = StateNextOutput;
+			StateNextOutput = (StateNextOutput + 1) % NumOutputs;
+		}
+
+		StateCompleted |= 1u << Index;
+		Context.TriggerOutput(OutputPins[Index].PinName);
+
+		if (StateCompleted == AllCompleted && bLoop)
+		{
+			StateNextOutput = 0;
+			StateCompleted = 0;
+		}
+	}
+	else if (PinName == TEXT("Reset"))
+	{
+		StateNextOutput = 0;
+		StateCompleted = 0;
+	}
 }
 
 #if WITH_EDITOR
+EDataValidationResult UFlowNode_ExecutionMultiGate::ValidateNode()
+{
+	if (OutputPins.Num() > MaxOutputs)
+	{
+		ValidationLog.Error<UFlowNode>(*FString::Printf(TEXT("Multi Gate supports up to %d outputs"), MaxOutputs), this);
+		return EDataValidationResult::Invalid;
+	}
+
+	return EDataValidationResult::Valid;
+}
+
 FString UFlowNode_ExecutionMultiGate::GetNodeDescription() const
 {
 	FString Result;
@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_ExecutionSequence.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ExecutionSequence)
 
@@ -48,17 +49,48 @@ void UFlowNode_ExecutionSequence::ExecuteNewConnections()
 {
 	for (const FFlowPin& Output : OutputPins)
 	{
-		const FConnectedPin& Connection = GetConnection(Output.PinName);
-		if (!ExecutedConnections.Contains(Connection.NodeGuid))
+		TArray<FConnectedPin> OutputConnections;
+		GetConnections(Output.PinName, OutputConnections);
+
+		// output connected to multiple inputs is tracked per connected node, only the new ones are triggered
+		TSet<FGuid> ExecutedNodes;
+		bool bHasNewConnections = false;
+		for (const FConnectedPin& Connection : OutputConnections)
 		{
-			ExecutedConnections.Emplace(Connection.NodeGuid);
-			TriggerOutput(Output.PinName, false);
+			if (ExecutedConnections.Contains(Connection.NodeGuid))
+			{
+				ExecutedNodes.Emplace(Connection.NodeGuid);
+			}
+			else
+			{
+				ExecutedConnections.Emplace(Connection.NodeGuid);
+				bHasNewConnections = true;
+			}
+		}
+
+		if (bHasNewConnections)
+		{
+			TriggerOutputExcludingNodes(Output.PinName, ExecutedNodes);
 		}
 	}
 
 	Finish();
 }
 
+int32 UFlowNode_ExecutionSequence::GetLightweightStateSize() const
+{
+	// executed connections can't be tracked without the node instance
+	return bSavePinExecutionState ? INDEX_NONE : 0;
+}
+
+void UFlowNode_ExecutionSequence::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	for (const FFlowPin& Output : OutputPins)
+	{
+		Context.TriggerOutput(Output.PinName);
+	}
+}
+
 #if WITH_EDITOR
 FString UFlowNode_ExecutionSequence::GetNodeDescription() const
 {
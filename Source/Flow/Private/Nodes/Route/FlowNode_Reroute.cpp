@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_Reroute.h"
+#include "Nodes/FlowLightweightNode.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Reroute)
 
@@ -18,3 +19,16 @@ void UFlowNode_Reroute::ExecuteInput(const FName& PinName)
 {
 	TriggerFirstOutput(true);
 }
+
+int32 UFlowNode_Reroute::GetLightweightStateSize() const
+{
+	return 0;
+}
+
+void UFlowNode_Reroute::ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const
+{
+	if (OutputPins.Num() > 0)
+	{
+		Context.TriggerOutput(OutputPins[0].PinName);
+	}
+}
@@ -28,13 +28,14 @@ UFlowNode_SubGraph::UFlowNode_SubGraph(const FObjectInitializer& ObjectInitializ
 
 bool UFlowNode_SubGraph::CanBeAssetInstanced() const
 {
-	return !Asset.IsNull() && (bCanInstanceIdenticalAsset || Asset.ToString() != GetFlowAsset()->GetTemplateAsset()->GetPathName());
+	return !IsInlined() && !Asset.IsNull() && (bCanInstanceIdenticalAsset || Asset.ToString() != GetFlowAsset()->GetTemplateAsset()->GetPathName());
 }
 
 void UFlowNode_SubGraph::PreloadContent()
 {
 	if (CanBeAssetInstanced() && GetFlowSubsystem())
 	{
+		GetFlowSubsystem()->WarmSubFlowPool(this);
 		GetFlowSubsystem()->CreateSubFlow(this, FString(), true);
 	}
 }
@@ -49,6 +50,12 @@ void UFlowNode_SubGraph::FlushContent()
 
 void UFlowNode_SubGraph::ExecuteInput(const FName& PinName)
 {
+	if (IsInlined())
+	{
+		GetFlowAsset()->TriggerInlinedSubGraph(this, PinName);
+		return;
+	}
+
 	if (CanBeAssetInstanced() == false)
 	{
 		if (Asset.IsNull())
@@ -79,7 +86,11 @@ void UFlowNode_SubGraph::ExecuteInput(const FName& PinName)
 
 void UFlowNode_SubGraph::Cleanup()
 {
-	if (CanBeAssetInstanced() && GetFlowSubsystem())
+	if (IsInlined())
+	{
+		GetFlowAsset()->FinishInlinedSubGraph(this);
+	}
+	else if (CanBeAssetInstanced() && GetFlowSubsystem())
 	{
 		GetFlowSubsystem()->RemoveSubFlow(this, EFlowFinishPolicy::Keep);
 	}
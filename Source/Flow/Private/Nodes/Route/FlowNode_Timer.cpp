@@ -1,9 +1,8 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/Route/FlowNode_Timer.h"
-
-#include "Engine/World.h"
-#include "TimerManager.h"
+#include "FlowSave.h"
+#include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_Timer)
 
@@ -14,6 +13,7 @@ UFlowNode_Timer::UFlowNode_Timer(const FObjectInitializer& ObjectInitializer)
 	, SumOfSteps(0.0f)
 	, RemainingCompletionTime(0.0f)
 	, RemainingStepTime(0.0f)
+	, bCompletionTimerActive(false)
 {
 #if WITH_EDITOR
 	Category = TEXT("Route");
@@ -53,25 +53,27 @@ void UFlowNode_Timer::ExecuteInput(const FName& PinName)
 
 void UFlowNode_Timer::SetTimer()
 {
-	if (GetWorld())
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
+		FFlowTimerWheel& TimerWheel = FlowSubsystem->GetTimerWheel();
+
 		if (StepTime > 0.0f)
 		{
-			GetWorld()->GetTimerManager().SetTimer(StepTimerHandle, this, &UFlowNode_Timer::OnStep, StepTime, true);
+			StepTimerHandle = TimerWheel.SetTimer(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnStep), StepTime, true);
 		}
 
 		if (CompletionTime > UE_KINDA_SMALL_NUMBER)
 		{
-			GetWorld()->GetTimerManager().SetTimer(CompletionTimerHandle, this, &UFlowNode_Timer::OnCompletion, CompletionTime, false);
+			CompletionTimerHandle = TimerWheel.SetTimer(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion), CompletionTime, false);
 		}
 		else
 		{
-			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UFlowNode_Timer::OnCompletion);
+			CompletionTimerHandle = TimerWheel.SetTimerForNextTick(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion));
 		}
 	}
 	else
 	{
-		LogError(TEXT("No valid world"));
+		LogError(TEXT("No valid Flow Subsystem"));
 		TriggerOutput(TEXT("Completed"), true);
 	}
 }
@@ -86,6 +88,16 @@ void UFlowNode_Timer::Restart()
 	SetTimer();
 }
 
+UObject* UFlowNode_Timer::GetTimerOwner() const
+{
+	if (UObject* RootFlowOwner = TryGetRootFlowObjectOwner())
+	{
+		return RootFlowOwner;
+	}
+
+	return const_cast<UFlowNode_Timer*>(this);
+}
+
 void UFlowNode_Timer::OnStep()
 {
 	SumOfSteps += StepTime;
@@ -107,16 +119,12 @@ void UFlowNode_Timer::OnCompletion()
 
 void UFlowNode_Timer::Cleanup()
 {
-	if (GetWorld())
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(CompletionTimerHandle);
+		FlowSubsystem->GetTimerWheel().ClearTimer(CompletionTimerHandle);
+		FlowSubsystem->GetTimerWheel().ClearTimer(StepTimerHandle);
 	}
 	CompletionTimerHandle.Invalidate();
-
-	if (GetWorld())
-	{
-		GetWorld()->GetTimerManager().ClearTimer(StepTimerHandle);
-	}
 	StepTimerHandle.Invalidate();
 
 	SumOfSteps = 0.0f;
@@ -124,34 +132,73 @@ void UFlowNode_Timer::Cleanup()
 
 void UFlowNode_Timer::OnSave_Implementation()
 {
-	if (GetWorld())
+	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 	{
-		if (CompletionTimerHandle.IsValid())
+		bCompletionTimerActive = FlowSubsystem->GetTimerWheel().IsTimerActive(CompletionTimerHandle);
+		if (bCompletionTimerActive)
 		{
-			RemainingCompletionTime = GetWorld()->GetTimerManager().GetTimerRemaining(CompletionTimerHandle);
+			RemainingCompletionTime = FlowSubsystem->GetTimerWheel().GetTimerRemaining(CompletionTimerHandle);
 		}
 
 		if (StepTimerHandle.IsValid())
 		{
-			RemainingStepTime = GetWorld()->GetTimerManager().GetTimerRemaining(StepTimerHandle);
+			RemainingStepTime = FlowSubsystem->GetTimerWheel().GetTimerRemaining(StepTimerHandle);
 		}
 	}
 }
 
 void UFlowNode_Timer::OnLoad_Implementation()
 {
-	if (RemainingStepTime > 0.0f || RemainingCompletionTime > 0.0f)
+	if (bCompletionTimerActive || RemainingStepTime > 0.0f || RemainingCompletionTime > 0.0f)
 	{
-		if (RemainingStepTime > 0.0f)
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 		{
-			GetWorld()->GetTimerManager().SetTimer(StepTimerHandle, this, &UFlowNode_Timer::OnStep, StepTime, true, RemainingStepTime);
+			FFlowTimerWheel& TimerWheel = FlowSubsystem->GetTimerWheel();
+
+			// time passed while the Flow Asset instance was hibernated, zero if we're loading the SaveGame
+			const float HibernatedTime = FlowSubsystem->GetHibernatedTime();
+
+			// step timer runs as long as the completion timer, zero remaining time means that step was due
+			if (StepTime > 0.0f)
+			{
+				RemainingStepTime = FMath::Max(0.0f, RemainingStepTime - HibernatedTime);
+				StepTimerHandle = TimerWheel.SetTimer(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnStep), StepTime, true, RemainingStepTime);
+			}
+
+			RemainingCompletionTime -= HibernatedTime;
+			if (RemainingCompletionTime > UE_KINDA_SMALL_NUMBER)
+			{
+				CompletionTimerHandle = TimerWheel.SetTimer(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion), RemainingCompletionTime, false);
+			}
+			else
+			{
+				CompletionTimerHandle = TimerWheel.SetTimerForNextTick(GetTimerOwner(), FFlowTimerDelegate::CreateUObject(this, &UFlowNode_Timer::OnCompletion));
+			}
 		}
 
-		GetWorld()->GetTimerManager().SetTimer(CompletionTimerHandle, this, &UFlowNode_Timer::OnCompletion, RemainingCompletionTime, false);
-
 		RemainingStepTime = 0.0f;
 		RemainingCompletionTime = 0.0f;
+		bCompletionTimerActive = false;
+	}
+}
+
+bool UFlowNode_Timer::CanHibernate(FFlowWakeUpConditions& OutConditions) const
+{
+	const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr || !CompletionTimerHandle.IsValid())
+	{
+		return false;
 	}
+
+	// instance wakes up in time for the nearest step or completion
+	const FFlowTimerWheel& TimerWheel = FlowSubsystem->GetTimerWheel();
+	OutConditions.AddDelay(TimerWheel.GetTimerRemaining(CompletionTimerHandle));
+	if (StepTimerHandle.IsValid())
+	{
+		OutConditions.AddDelay(TimerWheel.GetTimerRemaining(StepTimerHandle));
+	}
+
+	return true;
 }
 
 #if WITH_EDITOR
@@ -177,9 +224,9 @@ FString UFlowNode_Timer::GetStatusString() const
 		return FString::Printf(TEXT("Progress: %.*f"), 2, SumOfSteps);
 	}
 
-	if (CompletionTimerHandle.IsValid() && GetWorld())
+	if (CompletionTimerHandle.IsValid() && GetFlowSubsystem())
 	{
-		return FString::Printf(TEXT("Progress: %.*f"), 2, GetWorld()->GetTimerManager().GetTimerElapsed(CompletionTimerHandle));
+		return FString::Printf(TEXT("Progress: %.*f"), 2, GetFlowSubsystem()->GetTimerWheel().GetTimerElapsed(CompletionTimerHandle));
 	}
 
 	return FString();
@@ -13,6 +13,9 @@ UFlowNode_Checkpoint::UFlowNode_Checkpoint(const FObjectInitializer& ObjectIniti
 #if WITH_EDITOR
 	Category = TEXT("Utils");
 #endif
+
+	OutputPins.Add(FFlowPin(TEXT("Saved")));
+	OutputPins.Add(FFlowPin(TEXT("Failed")));
 }
 
 void UFlowNode_Checkpoint::ExecuteInput(const FName& PinName)
@@ -20,15 +23,63 @@ void UFlowNode_Checkpoint::ExecuteInput(const FName& PinName)
 	if (GetFlowSubsystem())
 	{
 		UFlowSaveGame* NewSaveGame = Cast<UFlowSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlowSaveGame::StaticClass()));
-		GetFlowSubsystem()->OnGameSaved(NewSaveGame);
+		PendingSaveGame = NewSaveGame;
+		GetFlowSubsystem()->SaveGameToSlotAsync(NewSaveGame, 0, FFlowSaveGameCompleted::CreateUObject(this, &UFlowNode_Checkpoint::OnSaveCompleted));
+
+		TriggerFirstOutput(false);
+		return;
+	}
+
+	TriggerFirstOutput(false);
+	TriggerOutput(TEXT("Saved"), true);
+}
+
+void UFlowNode_Checkpoint::OnSaveCompleted(UFlowSaveGame* SaveGame, const bool bSuccess)
+{
+	// graph has been finished while the save file was written, see DiscardPendingSave
+	if (SaveGame == nullptr || SaveGame != PendingSaveGame.Get() || GetActivationState() != EFlowNodeState::Active)
+	{
+		return;
+	}
+	PendingSaveGame.Reset();
+
+	if (bSuccess)
+	{
+		TriggerOutput(TEXT("Saved"), true);
+	}
+	else
+	{
+		LogError(TEXT("Failed to write the save file"));
+		TriggerOutput(TEXT("Failed"), true);
+	}
+}
 
-		UGameplayStatics::SaveGameToSlot(NewSaveGame, NewSaveGame->SaveSlotName, 0);
+void UFlowNode_Checkpoint::DiscardPendingSave()
+{
+	// writing the save file isn't cancelled, only its result is ignored
+	if (PendingSaveGame.IsValid())
+	{
+		PendingSaveGame.Reset();
+		LogWarning(TEXT("Checkpoint finished before the save file has been written, Saved and Failed won't be triggered"));
 	}
+}
 
-	TriggerFirstOutput(true);
+void UFlowNode_Checkpoint::Cleanup()
+{
+	DiscardPendingSave();
+	Super::Cleanup();
+}
+
+void UFlowNode_Checkpoint::DeinitializeInstance()
+{
+	// game-specific code might deinitialize the instance without deactivating its nodes
+	DiscardPendingSave();
+	Super::DeinitializeInstance();
 }
 
 void UFlowNode_Checkpoint::OnLoad_Implementation()
 {
-	TriggerFirstOutput(true);
+	// node has been saved while waiting for the save file to be written, so the state was captured before triggering Out
+	TriggerFirstOutput(false);
+	TriggerOutput(TEXT("Saved"), true);
 }
@@ -45,21 +45,28 @@ void UFlowNode_CallOwnerFunction::ExecuteInput(const FName& PinName)
 	const UClass* FlowOwnerClass = FlowOwnerObject->GetClass();
 	check(IsValid(FlowOwnerClass));
 
-	if (!FunctionRef.TryResolveFunction(*FlowOwnerClass))
+	if (!FunctionRef.TryResolveFunction(*FlowOwnerClass, *Params->GetClass()))
 	{
 		UE_LOG(
 			LogFlow,
 			Error,
-			TEXT("Could not resolve function named %s with flow owner class %s"),
+			TEXT("Could not resolve function named %s with flow owner class %s and params class %s"),
 			*FunctionRef.GetFunctionName().ToString(),
-			*FlowOwnerClass->GetName());
+			*FlowOwnerClass->GetName(),
+			*Params->GetClass()->GetName());
 
 		return;
 	}
 
+	// pins don't change at runtime
+	if (ValidOutputNames.Num() == 0)
+	{
+		ValidOutputNames = GetOutputNames();
+	}
+
 	Params->PreExecute(*this, PinName);
 
-	const FName ResultOutputName = FunctionRef.CallFunction(*FlowOwnerInterface, *Params);
+	const FName ResultOutputName = FunctionRef.CallFunction(*FlowOwnerInterface, *Params, ValidOutputNames);
 
 	Params->PostExecute();
 
@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Nodes/World/FlowNode_ComponentObserver.h"
+#include "FlowSave.h"
 #include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_ComponentObserver)
@@ -147,6 +148,18 @@ void UFlowNode_ComponentObserver::Cleanup()
 	SuccessCount = 0;
 }
 
+bool UFlowNode_ComponentObserver::CanHibernate(FFlowWakeUpConditions& OutConditions) const
+{
+	// observing starts again after waking up, so actors observed before hibernation would be reported again
+	if (!IdentityTags.IsValid() || RegisteredActors.Num() > 0)
+	{
+		return false;
+	}
+
+	OutConditions.IdentityTags.AppendTags(IdentityTags);
+	return true;
+}
+
 #if WITH_EDITOR
 FString UFlowNode_ComponentObserver::GetNodeDescription() const
 {
@@ -2,6 +2,7 @@
 
 #include "Nodes/World/FlowNode_OnNotifyFromActor.h"
 #include "FlowComponent.h"
+#include "FlowSave.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_OnNotifyFromActor)
 
@@ -42,6 +43,28 @@ void UFlowNode_OnNotifyFromActor::OnNotifyFromComponent(UFlowComponent* Componen
 	}
 }
 
+bool UFlowNode_OnNotifyFromActor::CanHibernate(FFlowWakeUpConditions& OutConditions) const
+{
+	// retroactive check after waking up would report the notify already received by this node
+	if (!IdentityTags.IsValid() || (bRetroactive && RegisteredActors.Num() > 0))
+	{
+		return false;
+	}
+
+	// notify can be sent only by already observed actors, so it's fine to wake up and observe them again
+	OutConditions.IdentityTags.AppendTags(IdentityTags);
+	if (NotifyTags.IsValid())
+	{
+		OutConditions.NotifyTags.AppendTags(NotifyTags);
+	}
+	else
+	{
+		OutConditions.bAnyNotifyTag = true;
+	}
+
+	return true;
+}
+
 #if WITH_EDITOR
 FString UFlowNode_OnNotifyFromActor::GetNodeDescription() const
 {
@@ -0,0 +1,93 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSave.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowAsyncNodeTest
+{
+	/* Waits for works launched so far, then runs their completions queued on the game thread */
+	void CompleteLaunchedWorks(UFlowTestNode_AsyncWork* Node)
+	{
+		UE::Tasks::Wait(Node->LaunchedWorks);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowAsyncNodeCompletionTest, "Flow.AsyncNode.Completion", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowAsyncNodeCompletionTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowAsyncNodeTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowTestNode_AsyncWork* AsyncWork = Fixture.AddNode<UFlowTestNode_AsyncWork>(Template);
+	UFlowTestNode_Recorder* Completed = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, AsyncWork);
+	FFlowTestFixture::Connect(AsyncWork, UFlowNode::DefaultOutputPin.PinName, Completed);
+	FFlowTestFixture::Compile(Template);
+
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(Owner, Template);
+
+	UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+	UFlowTestNode_AsyncWork* Node = FFlowTestFixture::GetNodeInstance(Instance, AsyncWork);
+	if (!TestNotNull(TEXT("Async node instance"), Node))
+	{
+		return false;
+	}
+	const UFlowTestNode_Recorder* CompletedRecorder = FFlowTestFixture::GetNodeInstance(Instance, Completed);
+
+	// completion triggers the output on the game thread
+	TestTrue(TEXT("Node waits for the work"), Node->IsAsyncWorkPending());
+	TestEqual(TEXT("Output waits for the completion"), CompletedRecorder->GetNumExecuted(), 0);
+	CompleteLaunchedWorks(Node);
+	TestFalse(TEXT("Node doesn't wait after the completion"), Node->IsAsyncWorkPending());
+	TestTrue(TEXT("Result of the work passed to the completion"), Node->CompletedResults == TArray<int32>({1}));
+	TestEqual(TEXT("Completion triggers the output"), CompletedRecorder->GetNumExecuted(), 1);
+
+	// relaunch discards the result of the previous work
+	FFlowTestFixture::TriggerInput(Instance, AsyncWork, UFlowNode::DefaultInputPin.PinName);
+	FFlowTestFixture::TriggerInput(Instance, AsyncWork, TEXT("Other"));
+	CompleteLaunchedWorks(Node);
+	TestTrue(TEXT("Only the last launched work completed"), Node->CompletedResults == TArray<int32>({1, 3}));
+	TestEqual(TEXT("Output triggered once for both launches"), CompletedRecorder->GetNumExecuted(), 2);
+
+	// loaded node executes the input that launched the pending work
+	FFlowTestFixture::TriggerInput(Instance, AsyncWork, TEXT("Other"));
+	FFlowNodeSaveData NodeRecord;
+	Node->SaveInstance(NodeRecord);
+	Node->LoadInstance(NodeRecord);
+	TestEqual(TEXT("Pending work restarted after loading"), Node->ExecutedInputs.Num(), 5);
+	TestTrue(TEXT("Restarted work launched by the same input"), Node->ExecutedInputs.Last() == TEXT("Other"));
+	CompleteLaunchedWorks(Node);
+	TestTrue(TEXT("Only the restarted work completed"), Node->CompletedResults == TArray<int32>({1, 3, 5}));
+
+	// Cleanup discards the result of work in flight
+	FFlowTestFixture::TriggerInput(Instance, AsyncWork, UFlowNode::DefaultInputPin.PinName);
+	FFlowTestFixture::TriggerInput(Instance, AsyncWork, TEXT("Finish"));
+	TestFalse(TEXT("Finished node doesn't wait for the work"), Node->IsAsyncWorkPending());
+	CompleteLaunchedWorks(Node);
+	TestTrue(TEXT("Work discarded by Cleanup doesn't complete"), Node->CompletedResults == TArray<int32>({1, 3, 5}));
+	TestEqual(TEXT("Output not triggered after Cleanup"), CompletedRecorder->GetNumExecuted(), 3);
+
+	FlowSubsystem->FinishRootFlow(Owner, Template, EFlowFinishPolicy::Keep);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
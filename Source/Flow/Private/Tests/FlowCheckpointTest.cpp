@@ -0,0 +1,160 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSave.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Utils/FlowNode_Checkpoint.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowCheckpointTest
+{
+	struct FCheckpointGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowNode_Checkpoint* Checkpoint = nullptr;
+		UFlowTestNode_Recorder* Out = nullptr;
+		UFlowTestNode_Recorder* Saved = nullptr;
+		UFlowTestNode_Recorder* Failed = nullptr;
+
+		explicit FCheckpointGraph(FFlowTestFixture& Fixture)
+		{
+			Template = Fixture.CreateTemplate();
+			UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+			Checkpoint = Fixture.AddNode<UFlowNode_Checkpoint>(Template);
+			Out = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+			Saved = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+			Failed = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Checkpoint);
+			FFlowTestFixture::Connect(Checkpoint, UFlowNode::DefaultOutputPin.PinName, Out);
+			FFlowTestFixture::Connect(Checkpoint, TEXT("Saved"), Saved);
+			FFlowTestFixture::Connect(Checkpoint, TEXT("Failed"), Failed);
+			FFlowTestFixture::Compile(Template);
+		}
+	};
+
+	/* Test writes the slot used by Checkpoint node, so the developer's save file is restored afterwards */
+	struct FScopedSlotBackup
+	{
+		FString SlotName;
+		TArray<uint8> SaveData;
+		bool bSlotExisted;
+
+		explicit FScopedSlotBackup(const FString& InSlotName)
+			: SlotName(InSlotName)
+			, bSlotExisted(UGameplayStatics::DoesSaveGameExist(InSlotName, 0))
+		{
+			if (bSlotExisted)
+			{
+				UGameplayStatics::LoadDataFromSlot(SaveData, SlotName, 0);
+			}
+		}
+
+		~FScopedSlotBackup()
+		{
+			if (bSlotExisted)
+			{
+				UGameplayStatics::SaveDataToSlot(SaveData, SlotName, 0);
+			}
+			else
+			{
+				UGameplayStatics::DeleteGameInSlot(SlotName, 0);
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowCheckpointSaveLoadTest, "Flow.Checkpoint.SaveAndLoad", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowCheckpointSaveLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowCheckpointTest;
+
+	const FString SlotName = GetDefault<UFlowSaveGame>()->SaveSlotName;
+	const FScopedSlotBackup SlotBackup(SlotName);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+	const FCheckpointGraph Graph(Fixture);
+	AActor* Owner = Fixture.SpawnOwner();
+
+	// state is captured and Out triggered immediately, Saved waits for writing the save file
+	FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+	UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+	if (!TestNotNull(TEXT("Root Flow instance"), Instance))
+	{
+		return false;
+	}
+
+	const UFlowNode_Checkpoint* Checkpoint = FFlowTestFixture::GetNodeInstance(Instance, Graph.Checkpoint);
+	TestTrue(TEXT("Save is being written"), FlowSubsystem->IsSavingGame());
+	TestTrue(TEXT("Checkpoint waits for the save file"), Checkpoint->GetActivationState() == EFlowNodeState::Active);
+	TestEqual(TEXT("Out triggered before writing the save file"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Out)->GetNumExecuted(), 1);
+	TestEqual(TEXT("Saved not triggered before writing the save file"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Saved)->GetNumExecuted(), 0);
+
+	Fixture.CompletePendingSaves();
+	TestFalse(TEXT("Save has been written"), FlowSubsystem->IsSavingGame());
+	TestTrue(TEXT("Checkpoint completed"), Checkpoint->GetActivationState() == EFlowNodeState::Completed);
+	TestEqual(TEXT("Saved triggered after writing the save file"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Saved)->GetNumExecuted(), 1);
+	TestEqual(TEXT("Failed not triggered"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Failed)->GetNumExecuted(), 0);
+
+	// loaded graph continues from the captured state, through both Out and Saved
+	{
+		UFlowSaveGame* LoadedSaveGame = Cast<UFlowSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, 0));
+		if (!TestNotNull(TEXT("Save file of the checkpoint"), LoadedSaveGame))
+		{
+			return false;
+		}
+
+		const FString SavedInstanceName = Instance->GetName();
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+		FlowSubsystem->OnGameLoaded(LoadedSaveGame);
+		FlowSubsystem->LoadRootFlow(Owner, Graph.Template, SavedInstanceName);
+
+		UFlowAsset* LoadedInstance = Fixture.GetRootInstance(Owner);
+		if (!TestNotNull(TEXT("Loaded Root Flow instance"), LoadedInstance))
+		{
+			return false;
+		}
+
+		TestTrue(TEXT("Loaded checkpoint completed"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Checkpoint)->GetActivationState() == EFlowNodeState::Completed);
+		TestEqual(TEXT("Out triggered after loading"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Out)->GetNumExecuted(), 1);
+		TestEqual(TEXT("Saved triggered after loading"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Saved)->GetNumExecuted(), 1);
+		TestEqual(TEXT("Failed not triggered after loading"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Failed)->GetNumExecuted(), 0);
+
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	// graph finished while writing the save file, the result is ignored instead of triggering outputs of finished graph
+	{
+		AddExpectedError(TEXT("Checkpoint finished before the save file has been written"), EAutomationExpectedErrorFlags::Contains, 1);
+
+		FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+		UFlowAsset* AbortedInstance = Fixture.GetRootInstance(Owner);
+		if (!TestNotNull(TEXT("Restarted Root Flow instance"), AbortedInstance))
+		{
+			return false;
+		}
+
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Abort);
+		TestTrue(TEXT("Save is still being written after aborting the graph"), FlowSubsystem->IsSavingGame());
+
+		Fixture.CompletePendingSaves();
+		TestFalse(TEXT("Save of aborted graph has been written"), FlowSubsystem->IsSavingGame());
+		TestTrue(TEXT("Aborted checkpoint stays aborted"), FFlowTestFixture::GetNodeInstance(AbortedInstance, Graph.Checkpoint)->GetActivationState() == EFlowNodeState::Aborted);
+		TestEqual(TEXT("Saved not triggered on aborted graph"), FFlowTestFixture::GetNodeInstance(AbortedInstance, Graph.Saved)->GetNumExecuted(), 0);
+		TestEqual(TEXT("Failed not triggered on aborted graph"), FFlowTestFixture::GetNodeInstance(AbortedInstance, Graph.Failed)->GetNumExecuted(), 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,102 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowComponent.h"
+#include "FlowSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowComponentRegistrySnapshotTest
+{
+	constexpr int32 NumComponents = 64;
+	constexpr int32 NumReaders = 8;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowComponentRegistrySnapshotTest, "Flow.ComponentRegistry.ConcurrentSnapshotReads", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowComponentRegistrySnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowComponentRegistrySnapshotTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+
+	// subsystem outside of running game instance isn't tickable, so only this test publishes snapshots
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GetTransientPackage(), NAME_None, RF_Transient);
+	UFlowSubsystem* FlowSubsystem = NewObject<UFlowSubsystem>(GameInstance, NAME_None, RF_Transient);
+
+	const FFlowComponentRegistrySnapshotRef InitialSnapshot = FlowSubsystem->GetRegistrySnapshot();
+
+	std::atomic<bool> bPublishing(true);
+	std::atomic<int32> NumReads(0);
+	std::atomic<int32> NumInconsistentReads(0);
+
+	// readers run on worker threads, while the game thread keeps publishing
+	UE::Tasks::FTask Readers = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&]()
+	{
+		ParallelFor(NumReaders, [&](int32 ReaderIndex)
+		{
+			int32 LastNum = 0;
+			do
+			{
+				const FFlowComponentRegistrySnapshotRef Snapshot = FlowSubsystem->GetRegistrySnapshot();
+
+				// weak pointers aren't resolved here, as garbage collection could run on the game thread
+				TArray<TWeakObjectPtr<UFlowComponent>> Components;
+				Snapshot->FindComponents(FGameplayTag::EmptyTag, true, Components);
+
+				TArray<TWeakObjectPtr<AActor>> Actors;
+				Snapshot->FindActors(FGameplayTag::EmptyTag, true, Actors);
+
+				// registry only grows in this test, so newer snapshot can't have fewer entries
+				if (Components.Num() != Actors.Num() || Components.Num() < LastNum || Components.Num() > NumComponents)
+				{
+					++NumInconsistentReads;
+				}
+
+				LastNum = Components.Num();
+				++NumReads;
+			}
+			while (bPublishing);
+		});
+	});
+
+	for (int32 Index = 0; Index < NumComponents; Index++)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		UFlowComponent* FlowComponent = NewObject<UFlowComponent>(Actor);
+
+		FlowSubsystem->FlowComponentRegistry.Emplace(FGameplayTag::EmptyTag, FlowComponent);
+		FlowSubsystem->PublishRegistrySnapshot();
+	}
+
+	bPublishing = false;
+	Readers.Wait();
+
+	TestTrue(TEXT("Snapshot has been read from worker threads"), NumReads > 0);
+	TestEqual(TEXT("Inconsistent snapshot reads"), NumInconsistentReads.load(), 0);
+	TestEqual(TEXT("Previously acquired snapshot doesn't change"), InitialSnapshot->NumTags(), 0);
+
+	TArray<TWeakObjectPtr<UFlowComponent>> Components;
+	FlowSubsystem->GetRegistrySnapshot()->FindComponents(FGameplayTag::EmptyTag, true, Components);
+	TestEqual(TEXT("Last published snapshot contains every component"), Components.Num(), NumComponents);
+
+	// readers don't keep the replaced snapshot alive, it's released by the following publish
+	const TWeakPtr<const FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe> ReplacedSnapshot = FlowSubsystem->GetRegistrySnapshot();
+	FlowSubsystem->PublishRegistrySnapshot();
+	TestTrue(TEXT("Replaced snapshot kept for readers of its epoch"), ReplacedSnapshot.IsValid());
+	FlowSubsystem->PublishRegistrySnapshot();
+	TestFalse(TEXT("Replaced snapshot released by the following publish"), ReplacedSnapshot.IsValid());
+	TestEqual(TEXT("No readers left in any epoch"), FlowSubsystem->RegistrySnapshotReaders[0].load() + FlowSubsystem->RegistrySnapshotReaders[1].load(), 0);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
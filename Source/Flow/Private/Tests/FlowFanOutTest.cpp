@@ -0,0 +1,114 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_ExecutionSequence.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowFanOutTest
+{
+	constexpr int32 NumTargets = 8;
+	constexpr int32 NumSignals = 10000;
+
+	/* Source node passing the signal to every target, either directly or through a Sequence node */
+	struct FFanOutGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowTestNode_Recorder* Source = nullptr;
+		TArray<UFlowTestNode_Recorder*> Targets;
+
+		FFanOutGraph(FFlowTestFixture& Fixture, const bool bUseSequence)
+		{
+			Template = Fixture.CreateTemplate();
+			Fixture.AddNode<UFlowNode_Start>(Template);
+			Source = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			UFlowNode_ExecutionSequence* Sequence = nullptr;
+			if (bUseSequence)
+			{
+				Sequence = Fixture.AddNode<UFlowNode_ExecutionSequence>(Template);
+				FFlowTestFixture::SetNumberedOutputPins(Sequence, NumTargets);
+				FFlowTestFixture::Connect(Source, UFlowNode::DefaultOutputPin.PinName, Sequence);
+			}
+
+			for (int32 Index = 0; Index < NumTargets; Index++)
+			{
+				UFlowTestNode_Recorder* Target = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+				if (Sequence)
+				{
+					FFlowTestFixture::Connect(Sequence, FName(*FString::FromInt(Index)), Target);
+				}
+				else
+				{
+					FFlowTestFixture::Connect(Source, UFlowNode::DefaultOutputPin.PinName, Target);
+				}
+				Targets.Add(Target);
+			}
+
+			FFlowTestFixture::Compile(Template);
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFanOutPropagationBenchmark, "Flow.Performance.FanOutPropagation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFlowFanOutPropagationBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace FlowFanOutTest;
+
+	// Sequence is measured as an instanced node, the same way the fan-out source is executed
+	const TGuardValue<bool> LightweightGuard(UFlowSettings::Get()->bLightweightRouteNodes, false);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// output connected to every target is compared with the Sequence node it replaces
+	double Nanoseconds[2] = {};
+	for (const bool bUseSequence : {false, true})
+	{
+		const FString Context = bUseSequence ? TEXT("Sequence") : TEXT("fan-out");
+
+		const FFanOutGraph Graph(Fixture, bUseSequence);
+		AActor* Owner = Fixture.SpawnOwner();
+		FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+
+		UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+		if (!TestNotNull(FString::Printf(TEXT("Root Flow instance, %s"), *Context), Instance))
+		{
+			return false;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumSignals; i++)
+		{
+			FFlowTestFixture::TriggerInput(Instance, Graph.Source, UFlowNode::DefaultInputPin.PinName);
+		}
+		Nanoseconds[bUseSequence ? 1 : 0] = (FPlatformTime::Seconds() - StartTime) * 1e9 / NumSignals;
+
+		for (const UFlowTestNode_Recorder* Target : Graph.Targets)
+		{
+			TestEqual(FString::Printf(TEXT("Signals received by every target, %s"), *Context), FFlowTestFixture::GetNodeInstance(Instance, Target)->GetNumExecuted(), NumSignals);
+		}
+
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	AddInfo(FString::Printf(TEXT("Signal passed to %d inputs: fan-out %.1f ns, Sequence %.1f ns, %d signals each"), NumTargets, Nanoseconds[0], Nanoseconds[1], NumSignals));
+	if (Nanoseconds[0] > Nanoseconds[1])
+	{
+		AddWarning(TEXT("Output fan-out isn't faster than the Sequence node"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
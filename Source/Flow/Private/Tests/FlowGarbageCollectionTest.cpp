@@ -0,0 +1,212 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Finish.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowGarbageCollectionTest
+{
+	constexpr int32 NumTemplates = 100;
+	constexpr int32 NodesPerTemplate = 200;
+	constexpr int32 NumPasses = 5;
+
+	/* Templates are clustered only outside of the editor, the way cooked assets are loaded */
+	bool ClusterTemplate(UFlowAsset* Template)
+	{
+		if (Template->CanBeClusterRoot())
+		{
+			Template->CreateCluster();
+			return true;
+		}
+		return false;
+	}
+
+	/* Average duration of the full garbage collection, in milliseconds */
+	double MeasureGarbageCollection()
+	{
+		// the first pass collects objects left by preceding tests
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; Pass++)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumPasses;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowInstancesGarbageCollectionTest, "Flow.GarbageCollection.InstancesKeptBySubsystem", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowInstancesGarbageCollectionTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowGarbageCollectionTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// active Sub Graph stays instanced, finished Sub Graph goes to the pool
+	UFlowAsset* ActiveSubGraphTemplate = Fixture.CreateTemplate();
+	UFlowNode_Start* ActiveSubGraphStart = Fixture.AddNode<UFlowNode_Start>(ActiveSubGraphTemplate);
+	UFlowTestNode_Recorder* ActiveSubGraphRecorder = Fixture.AddNode<UFlowTestNode_Recorder>(ActiveSubGraphTemplate);
+	ActiveSubGraphRecorder->bStayActive = true;
+	FFlowTestFixture::Connect(ActiveSubGraphStart, UFlowNode::DefaultOutputPin.PinName, ActiveSubGraphRecorder);
+	FFlowTestFixture::Compile(ActiveSubGraphTemplate);
+
+	UFlowAsset* PooledSubGraphTemplate = Fixture.CreateTemplate();
+	PooledSubGraphTemplate->MaxPooledInstances = 1;
+	UFlowNode_Start* PooledSubGraphStart = Fixture.AddNode<UFlowNode_Start>(PooledSubGraphTemplate);
+	UFlowNode_Finish* PooledSubGraphFinish = Fixture.AddNode<UFlowNode_Finish>(PooledSubGraphTemplate);
+	FFlowTestFixture::Connect(PooledSubGraphStart, UFlowNode::DefaultOutputPin.PinName, PooledSubGraphFinish);
+	FFlowTestFixture::Compile(PooledSubGraphTemplate);
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowNode_SubGraph* ActiveSubGraph = Fixture.AddNode<UFlowNode_SubGraph>(Template);
+	UFlowNode_SubGraph* PooledSubGraph = Fixture.AddNode<UFlowNode_SubGraph>(Template);
+	UFlowTestNode_Recorder* Recorder = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	Recorder->bStayActive = true;
+	FFlowTestFixture::SetSubGraphAsset(ActiveSubGraph, ActiveSubGraphTemplate);
+	FFlowTestFixture::SetSubGraphAsset(PooledSubGraph, PooledSubGraphTemplate);
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, ActiveSubGraph, TEXT("Start"));
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, PooledSubGraph, TEXT("Start"));
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Recorder);
+	FFlowTestFixture::Compile(Template);
+
+	// clustered template doesn't trace its instances, only the subsystem keeps them alive
+	bool bClustered = false;
+	for (UFlowAsset* ClusteredTemplate : {ActiveSubGraphTemplate, PooledSubGraphTemplate, Template})
+	{
+		bClustered |= ClusterTemplate(ClusteredTemplate);
+	}
+	if (!bClustered)
+	{
+		AddInfo(TEXT("Templates aren't clustered in the editor, run with -game to cover clustered templates"));
+	}
+
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(Owner, Template);
+
+	const TWeakObjectPtr<UFlowAsset> RootInstance = Fixture.GetRootInstance(Owner);
+	if (!TestTrue(TEXT("Root Flow instance"), RootInstance.IsValid()))
+	{
+		return false;
+	}
+
+	const TWeakObjectPtr<UFlowAsset> SubFlowInstance = RootInstance->GetFlowInstance(FFlowTestFixture::GetNodeInstance(RootInstance.Get(), ActiveSubGraph));
+	const TArray<UFlowAsset*> PooledInstances = Fixture.GetPooledInstances(PooledSubGraphTemplate);
+	if (!TestTrue(TEXT("Sub Flow instance"), SubFlowInstance.IsValid()) || !TestEqual(TEXT("Finished Sub Graph instance pooled"), PooledInstances.Num(), 1))
+	{
+		return false;
+	}
+
+	const TWeakObjectPtr<UFlowAsset> PooledInstance = PooledInstances[0];
+	const TWeakObjectPtr<UFlowTestNode_Recorder> RecorderInstance = FFlowTestFixture::GetNodeInstance(RootInstance.Get(), Recorder);
+	const TWeakObjectPtr<UFlowTestNode_Recorder> SubFlowRecorderInstance = FFlowTestFixture::GetNodeInstance(SubFlowInstance.Get(), ActiveSubGraphRecorder);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	TestTrue(TEXT("Root Flow instance survives garbage collection"), RootInstance.IsValid());
+	TestTrue(TEXT("Sub Flow instance survives garbage collection"), SubFlowInstance.IsValid());
+	TestTrue(TEXT("Pooled instance survives garbage collection"), PooledInstance.IsValid());
+	TestTrue(TEXT("Node of Root Flow instance survives garbage collection"), RecorderInstance.IsValid());
+	TestTrue(TEXT("Node of Sub Flow instance survives garbage collection"), SubFlowRecorderInstance.IsValid());
+	TestEqual(TEXT("Template still tracks its instance"), Template->GetInstancesNum(), 1);
+
+	// instances keep working after the collection
+	if (RecorderInstance.IsValid())
+	{
+		FFlowTestFixture::TriggerInput(RootInstance.Get(), Recorder, UFlowNode::DefaultInputPin.PinName);
+		TestEqual(TEXT("Node executed after garbage collection"), RecorderInstance->GetNumExecuted(), 2);
+	}
+
+	// finished instances are released by the subsystem
+	FlowSubsystem->FinishRootFlow(Owner, Template, EFlowFinishPolicy::Keep);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	TestFalse(TEXT("Finished Root Flow instance collected"), RootInstance.IsValid());
+	TestFalse(TEXT("Finished Sub Flow instance collected"), SubFlowInstance.IsValid());
+	TestEqual(TEXT("Template dropped the collected instance"), Template->GetInstancesNum(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowGarbageCollectionBenchmark, "Flow.Performance.GarbageCollection", EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FFlowGarbageCollectionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace FlowGarbageCollectionTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// every template and its instance hold the same number of live nodes
+	TArray<UFlowAsset*> Templates;
+	for (int32 TemplateIndex = 0; TemplateIndex < NumTemplates; TemplateIndex++)
+	{
+		UFlowAsset* Template = Fixture.CreateTemplate();
+		UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+		UFlowTestNode_Recorder* Recorder = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+		Recorder->bStayActive = true;
+		FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Recorder);
+
+		for (int32 NodeIndex = Template->GetNodes().Num(); NodeIndex < NodesPerTemplate; NodeIndex++)
+		{
+			Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+		}
+
+		FFlowTestFixture::Compile(Template);
+		Templates.Add(Template);
+	}
+
+	TArray<AActor*> Owners;
+	for (UFlowAsset* Template : Templates)
+	{
+		AActor* Owner = Fixture.SpawnOwner();
+		FlowSubsystem->StartRootFlow(Owner, Template);
+		Owners.Add(Owner);
+	}
+
+	const int32 NumLiveNodes = NumTemplates * NodesPerTemplate * 2;
+	const double UnclusteredTime = MeasureGarbageCollection();
+
+	// templates are clustered the way cooked assets are clustered on load
+	int32 NumClustered = 0;
+	for (UFlowAsset* Template : Templates)
+	{
+		NumClustered += ClusterTemplate(Template) ? 1 : 0;
+	}
+	if (NumClustered == 0)
+	{
+		AddWarning(TEXT("Templates aren't clustered in the editor, run the benchmark with -game"));
+		return true;
+	}
+
+	const double ClusteredTime = MeasureGarbageCollection();
+
+	for (int32 Index = 0; Index < Owners.Num(); Index++)
+	{
+		TestNotNull(TEXT("Root Flow instance survives garbage collection"), Fixture.GetRootInstance(Owners[Index]));
+		FlowSubsystem->FinishRootFlow(Owners[Index], Templates[Index], EFlowFinishPolicy::Keep);
+	}
+
+	AddInfo(FString::Printf(TEXT("Garbage collection with %d live nodes: unclustered templates %.2f ms, clustered templates %.2f ms, %d passes each"), NumLiveNodes, UnclusteredTime, ClusteredTime, NumPasses));
+	if (ClusteredTime > UnclusteredTime)
+	{
+		AddWarning(TEXT("Clustered templates didn't reduce the garbage collection time"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
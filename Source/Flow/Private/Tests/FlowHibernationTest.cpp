@@ -0,0 +1,140 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_Timer.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowHibernationTest
+{
+	constexpr float CompletionTime = 2.0f;
+	constexpr float StepTime = 0.5f;
+	constexpr float DeltaTime = 0.05f;
+
+	/* Timer properties are edited only in the editor, so the test sets them the way Details panel does */
+	void SetTimerProperty(UFlowNode_Timer* Timer, const FName& PropertyName, const float Value)
+	{
+		const FFloatProperty* Property = FindFProperty<FFloatProperty>(UFlowNode_Timer::StaticClass(), PropertyName);
+		Property->SetPropertyValue_InContainer(Timer, Value);
+	}
+
+	/* Timer triggering steps before completing, its state is restored from the hibernation record */
+	struct FTimerGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowNode_Timer* Timer = nullptr;
+		UFlowTestNode_Recorder* Step = nullptr;
+		UFlowTestNode_Recorder* Completed = nullptr;
+
+		explicit FTimerGraph(FFlowTestFixture& Fixture)
+		{
+			Template = Fixture.CreateTemplate();
+			UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+			Timer = Fixture.AddNode<UFlowNode_Timer>(Template);
+			SetTimerProperty(Timer, TEXT("CompletionTime"), CompletionTime);
+			SetTimerProperty(Timer, TEXT("StepTime"), StepTime);
+			Step = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+			Completed = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Timer);
+			FFlowTestFixture::Connect(Timer, TEXT("Step"), Step);
+			FFlowTestFixture::Connect(Timer, TEXT("Completed"), Completed);
+			FFlowTestFixture::Compile(Template);
+		}
+	};
+
+	/* Restored instance has new node objects, so executions are summed over every instance */
+	struct FExecutions
+	{
+		int32 Steps = 0;
+		int32 Completed = 0;
+
+		void Add(const FTimerGraph& Graph, const UFlowAsset* Instance)
+		{
+			if (Instance)
+			{
+				Steps += FFlowTestFixture::GetNodeInstance(Instance, Graph.Step)->GetNumExecuted();
+				Completed += FFlowTestFixture::GetNodeInstance(Instance, Graph.Completed)->GetNumExecuted();
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowHibernationRoundTripTest, "Flow.Hibernation.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowHibernationRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowHibernationTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+	const FTimerGraph Graph(Fixture);
+
+	// the same graph runs without hibernation as a reference
+	AActor* ReferenceOwner = Fixture.SpawnOwner();
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(ReferenceOwner, Graph.Template);
+	FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+
+	Fixture.Tick(DeltaTime, FMath::RoundToInt(0.75f / DeltaTime));
+
+	// hibernated instance is destroyed, only its record is kept
+	FExecutions Executions;
+	const TWeakObjectPtr<UFlowAsset> HibernatedInstance = Fixture.GetRootInstance(Owner);
+	Executions.Add(Graph, HibernatedInstance.Get());
+	TestEqual(TEXT("Step triggered before hibernating"), Executions.Steps, 1);
+
+	if (!TestTrue(TEXT("Root Flow with active Timer hibernates"), FlowSubsystem->HibernateRootFlow(Owner, Graph.Template)))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Root Flow hibernated"), FlowSubsystem->IsRootFlowHibernated(Owner, Graph.Template));
+	TestEqual(TEXT("Hibernated flows"), FlowSubsystem->GetNumHibernatedFlows(), 1);
+	TestNull(TEXT("Hibernated Root Flow has no instance"), Fixture.GetRootInstance(Owner));
+	TestTrue(TEXT("Hibernated instance marked as garbage"), !HibernatedInstance.IsValid());
+
+	// instance wakes up for the next step of the Timer, restored Timer continues where it stopped
+	Fixture.Tick(DeltaTime, FMath::RoundToInt(0.5f / DeltaTime));
+	TestFalse(TEXT("Root Flow woken up by the Timer"), FlowSubsystem->IsRootFlowHibernated(Owner, Graph.Template));
+	UFlowAsset* RestoredInstance = Fixture.GetRootInstance(Owner);
+	if (!TestNotNull(TEXT("Restored Root Flow instance"), RestoredInstance))
+	{
+		return false;
+	}
+
+	// round trip is repeated on demand, without waiting for the wake-up conditions
+	Executions.Add(Graph, RestoredInstance);
+	TestTrue(TEXT("Restored Root Flow hibernates again"), FlowSubsystem->HibernateRootFlow(Owner, Graph.Template));
+	FlowSubsystem->WakeUpRootFlow(Owner, Graph.Template);
+	TestFalse(TEXT("Root Flow woken up on demand"), FlowSubsystem->IsRootFlowHibernated(Owner, Graph.Template));
+	RestoredInstance = Fixture.GetRootInstance(Owner);
+	if (!TestNotNull(TEXT("Root Flow instance woken up on demand"), RestoredInstance))
+	{
+		return false;
+	}
+
+	Fixture.Tick(DeltaTime, FMath::RoundToInt(CompletionTime / DeltaTime));
+	Executions.Add(Graph, RestoredInstance);
+
+	FExecutions ReferenceExecutions;
+	ReferenceExecutions.Add(Graph, Fixture.GetRootInstance(ReferenceOwner));
+	TestEqual(TEXT("Reference Timer completed"), ReferenceExecutions.Completed, 1);
+	TestEqual(TEXT("Steps match the flow that never hibernated"), Executions.Steps, ReferenceExecutions.Steps);
+	TestEqual(TEXT("Completed once after hibernating twice"), Executions.Completed, 1);
+	TestEqual(TEXT("No hibernated flows left"), FlowSubsystem->GetNumHibernatedFlows(), 0);
+
+	FlowSubsystem->FinishRootFlow(ReferenceOwner, Graph.Template, EFlowFinishPolicy::Keep);
+	FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Finish.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowInlinedSubGraphTest, "Flow.SubGraph.Inlining", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFlowInlinedSubGraphTest::RunTest(const FString& Parameters)
+{
+	const TGuardValue<int32> MaxNodesGuard(UFlowSettings::Get()->MaxInlinedSubGraphNodes, 8);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// Sub Graph finishes right after recording its execution
+	UFlowAsset* SubGraphTemplate = Fixture.CreateTemplate();
+	UFlowNode_Start* SubGraphStart = Fixture.AddNode<UFlowNode_Start>(SubGraphTemplate);
+	UFlowTestNode_Recorder* SubGraphRecorder = Fixture.AddNode<UFlowTestNode_Recorder>(SubGraphTemplate);
+	UFlowNode_Finish* SubGraphFinish = Fixture.AddNode<UFlowNode_Finish>(SubGraphTemplate);
+	FFlowTestFixture::Connect(SubGraphStart, UFlowNode::DefaultOutputPin.PinName, SubGraphRecorder);
+	FFlowTestFixture::Connect(SubGraphRecorder, UFlowNode::DefaultOutputPin.PinName, SubGraphFinish);
+	FFlowTestFixture::Compile(SubGraphTemplate);
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowNode_SubGraph* SubGraph = Fixture.AddNode<UFlowNode_SubGraph>(Template);
+	UFlowTestNode_Recorder* AfterSubGraph = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	AfterSubGraph->bStayActive = true;
+	FFlowTestFixture::SetSubGraphAsset(SubGraph, SubGraphTemplate);
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, SubGraph, TEXT("Start"));
+	FFlowTestFixture::Connect(SubGraph, TEXT("Finish"), AfterSubGraph);
+
+	const int32 NumTemplateNodes = Template->GetNodes().Num();
+	FFlowTestFixture::InlineSubGraphs(Template);
+	FFlowTestFixture::Compile(Template);
+
+	if (!TestTrue(TEXT("Sub Graph inlined"), SubGraph->IsInlined()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Nodes of the Sub Graph copied into the template"), Template->GetNodes().Num(), NumTemplateNodes + SubGraphTemplate->GetNodes().Num());
+
+	// inlined guids are derived from the Sub Graph node, while the source guid points back to the Sub Graph asset
+	const FGuid InlinedRecorderGuid = FGuid::Combine(SubGraph->GetGuid(), SubGraphRecorder->GetGuid());
+	for (const TPair<FGuid, UFlowNode*>& SourceNode : SubGraphTemplate->GetNodes())
+	{
+		const FFlowInlinedNode* InlinedNode = Template->FindInlinedNode(FGuid::Combine(SubGraph->GetGuid(), SourceNode.Key));
+		if (TestNotNull(TEXT("Inlined node registered"), InlinedNode))
+		{
+			TestEqual(TEXT("Sub Graph node of the inlined node"), InlinedNode->SubGraphNodeGuid, SubGraph->GetGuid());
+			TestEqual(TEXT("Source node of the inlined node"), InlinedNode->SourceNodeGuid, SourceNode.Key);
+		}
+	}
+	TestNull(TEXT("Nodes of the parent graph aren't inlined"), Template->FindInlinedNode(AfterSubGraph->GetGuid()));
+
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(Owner, Template);
+
+	UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+	if (!TestNotNull(TEXT("Root Flow instance"), Instance))
+	{
+		return false;
+	}
+
+	UFlowNode_SubGraph* SubGraphInstance = FFlowTestFixture::GetNodeInstance(Instance, SubGraph);
+	TestFalse(TEXT("Inlined Sub Graph doesn't create the Flow Asset instance"), Instance->GetFlowInstance(SubGraphInstance).IsValid());
+	TestEqual(TEXT("No Sub Flows instanced"), FlowSubsystem->GetInstancedSubFlows().Num(), 0);
+
+	const UFlowTestNode_Recorder* InlinedRecorder = Instance->GetNode<UFlowTestNode_Recorder>(InlinedRecorderGuid);
+	if (!TestNotNull(TEXT("Inlined node instance"), InlinedRecorder))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Inlined node executed by the parent instance"), InlinedRecorder->GetNumExecuted(), 1);
+	TestTrue(TEXT("Inlined node attributed to the Sub Graph node"), Instance->GetInlinedSubGraphNode(InlinedRecorder) == SubGraphInstance);
+	TestEqual(TEXT("Finish of the inlined Sub Graph triggers the Sub Graph output"), FFlowTestFixture::GetNodeInstance(Instance, AfterSubGraph)->GetNumExecuted(), 1);
+
+	// Sub Graph triggered again starts from its entry node
+	FFlowTestFixture::TriggerInput(Instance, SubGraph, TEXT("Start"));
+	TestEqual(TEXT("Inlined node executed again"), InlinedRecorder->GetNumExecuted(), 2);
+	TestEqual(TEXT("Sub Graph output triggered again"), FFlowTestFixture::GetNodeInstance(Instance, AfterSubGraph)->GetNumExecuted(), 2);
+
+	FlowSubsystem->FinishRootFlow(Owner, Template, EFlowFinishPolicy::Keep);
+
+	// editor asset is left as it was before cooking
+	FFlowTestFixture::RestoreInlinedSubGraphs(Template);
+	FFlowTestFixture::Compile(Template);
+	TestFalse(TEXT("Sub Graph node restored"), SubGraph->IsInlined());
+	TestEqual(TEXT("Inlined nodes removed from the template"), Template->GetNodes().Num(), NumTemplateNodes);
+	TestNull(TEXT("Inlined node unregistered"), Template->FindInlinedNode(InlinedRecorderGuid));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -0,0 +1,141 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSave.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Counter.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowLightweightNodesTest
+{
+	/* Start increments the Counter once, its goal is reached by the second increment */
+	struct FCounterGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowNode_Counter* Counter = nullptr;
+		UFlowTestNode_Recorder* Step = nullptr;
+		UFlowTestNode_Recorder* Goal = nullptr;
+
+		explicit FCounterGraph(FFlowTestFixture& Fixture)
+		{
+			Template = Fixture.CreateTemplate();
+			UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+			Counter = Fixture.AddNode<UFlowNode_Counter>(Template);
+			Step = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+			Goal = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Counter, TEXT("Increment"));
+			FFlowTestFixture::Connect(Counter, TEXT("Step"), Step);
+			FFlowTestFixture::Connect(Counter, TEXT("Goal"), Goal);
+			FFlowTestFixture::Compile(Template);
+		}
+	};
+
+	/* Saves the Root Flow, finishes it and loads it again like loading the game would */
+	UFlowAsset* SaveAndLoadRootFlow(FFlowTestFixture& Fixture, AActor* Owner, UFlowAsset* Template)
+	{
+		UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+		const FString SavedInstanceName = Fixture.GetRootInstance(Owner)->GetName();
+
+		UFlowSaveGame* SaveGame = NewObject<UFlowSaveGame>(GetTransientPackage());
+		FlowSubsystem->OnGameSaved(SaveGame);
+		FlowSubsystem->FinishRootFlow(Owner, Template, EFlowFinishPolicy::Keep);
+
+		FlowSubsystem->OnGameLoaded(SaveGame);
+		FlowSubsystem->LoadRootFlow(Owner, Template, SavedInstanceName);
+		return Fixture.GetRootInstance(Owner);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowLightweightNodesSaveLoadTest, "Flow.LightweightNodes.SaveAndLoad", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowLightweightNodesSaveLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowLightweightNodesTest;
+
+	// editor keeps node instances by default, so the test opts in the same way PIE would
+	UFlowSettings* Settings = UFlowSettings::Get();
+	const TGuardValue<bool> LightweightGuard(Settings->bLightweightRouteNodes, true);
+	const TGuardValue<bool> LightweightInEditorGuard(Settings->bLightweightRouteNodesInEditor, true);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+	const FCounterGraph Graph(Fixture);
+	AActor* Owner = Fixture.SpawnOwner();
+
+	// state of the lightweight node is restored from the SaveGame
+	{
+		FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+		UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+		if (!TestNotNull(TEXT("Root Flow instance"), Instance))
+		{
+			return false;
+		}
+
+		TestNull(TEXT("Counter executed without the node instance"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Counter));
+		TestTrue(TEXT("Counter state after the first increment"), FFlowTestFixture::GetLightweightNodeStates(Instance) == TArray<int32>({1}));
+		TestEqual(TEXT("Step triggered by the first increment"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Step)->GetNumExecuted(), 1);
+
+		UFlowAsset* LoadedInstance = SaveAndLoadRootFlow(Fixture, Owner, Graph.Template);
+		if (!TestNotNull(TEXT("Loaded Root Flow instance"), LoadedInstance))
+		{
+			return false;
+		}
+
+		TestTrue(TEXT("Loaded Counter state"), FFlowTestFixture::GetLightweightNodeStates(LoadedInstance) == TArray<int32>({1}));
+
+		FFlowTestFixture::TriggerInput(LoadedInstance, Graph.Counter, TEXT("Increment"));
+		TestEqual(TEXT("Goal reached by the increment after loading"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Goal)->GetNumExecuted(), 1);
+		TestTrue(TEXT("Counter state reset by reaching the goal"), FFlowTestFixture::GetLightweightNodeStates(LoadedInstance) == TArray<int32>({0}));
+
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	// SaveGame written while nodes had instances doesn't contain lightweight states, so these are reset
+	{
+		UFlowAsset* Instance = nullptr;
+		{
+			const TGuardValue<bool> InstancedNodesGuard(Settings->bLightweightRouteNodes, false);
+
+			FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+			Instance = Fixture.GetRootInstance(Owner);
+			if (!TestNotNull(TEXT("Root Flow instance with instanced nodes"), Instance))
+			{
+				return false;
+			}
+
+			TestNotNull(TEXT("Counter instanced while lightweight nodes are disabled"), FFlowTestFixture::GetNodeInstance(Instance, Graph.Counter));
+			TestEqual(TEXT("No lightweight states while lightweight nodes are disabled"), FFlowTestFixture::GetLightweightNodeStates(Instance).Num(), 0);
+		}
+
+		AddExpectedError(TEXT("don't match the SaveGame, resetting them"), EAutomationExpectedErrorFlags::Contains, 1);
+
+		UFlowAsset* LoadedInstance = SaveAndLoadRootFlow(Fixture, Owner, Graph.Template);
+		if (!TestNotNull(TEXT("Root Flow loaded with lightweight nodes"), LoadedInstance))
+		{
+			return false;
+		}
+
+		TestNull(TEXT("Counter executed without the node instance after loading"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Counter));
+		TestTrue(TEXT("Mismatched Counter state reset"), FFlowTestFixture::GetLightweightNodeStates(LoadedInstance) == TArray<int32>({0}));
+
+		FFlowTestFixture::TriggerInput(LoadedInstance, Graph.Counter, TEXT("Increment"));
+		TestEqual(TEXT("Reset Counter triggers Step"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Step)->GetNumExecuted(), 1);
+		TestEqual(TEXT("Reset Counter doesn't reach the goal"), FFlowTestFixture::GetNodeInstance(LoadedInstance, Graph.Goal)->GetNumExecuted(), 0);
+
+		FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
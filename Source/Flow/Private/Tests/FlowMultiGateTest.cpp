@@ -0,0 +1,148 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_ExecutionMultiGate.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowMultiGateTest
+{
+	/* Multi Gate with a Recorder connected to every output, executed by its own Root Flow */
+	struct FMultiGateGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowNode_ExecutionMultiGate* MultiGate = nullptr;
+		TArray<UFlowTestNode_Recorder*> Outputs;
+
+		FMultiGateGraph(FFlowTestFixture& Fixture, const int32 NumOutputs, const bool bRandom, const bool bLoop, const int32 StartIndex = INDEX_NONE)
+		{
+			Template = Fixture.CreateTemplate();
+			Fixture.AddNode<UFlowNode_Start>(Template);
+
+			MultiGate = Fixture.AddNode<UFlowNode_ExecutionMultiGate>(Template);
+			MultiGate->bRandom = bRandom;
+			MultiGate->bLoop = bLoop;
+			MultiGate->StartIndex = StartIndex;
+			FFlowTestFixture::SetNumberedOutputPins(MultiGate, NumOutputs);
+
+			for (int32 Index = 0; Index < NumOutputs; Index++)
+			{
+				UFlowTestNode_Recorder* Output = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+				FFlowTestFixture::Connect(MultiGate, FName(*FString::FromInt(Index)), Output);
+				Outputs.Add(Output);
+			}
+
+			FFlowTestFixture::Compile(Template);
+		}
+
+		/* Number of executions of every output */
+		TArray<int32> GetExecutions(const UFlowAsset* Instance) const
+		{
+			TArray<int32> Executions;
+			for (const UFlowTestNode_Recorder* Output : Outputs)
+			{
+				Executions.Add(FFlowTestFixture::GetNodeInstance(Instance, Output)->GetNumExecuted());
+			}
+			return Executions;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowMultiGateStateTest, "Flow.MultiGate.State", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowMultiGateStateTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowMultiGateTest;
+
+	UFlowSettings* Settings = UFlowSettings::Get();
+	const TGuardValue<bool> LightweightInEditorGuard(Settings->bLightweightRouteNodesInEditor, true);
+
+	// the same scenarios are executed by the node instance and by the lightweight state
+	for (const bool bLightweight : {false, true})
+	{
+		const TGuardValue<bool> LightweightGuard(Settings->bLightweightRouteNodes, bLightweight);
+		const FString Mode = bLightweight ? TEXT("lightweight") : TEXT("instanced");
+
+		FFlowTestFixture Fixture;
+		UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+		// sequence triggers every output once, Reset starts it again
+		{
+			const FMultiGateGraph Graph(Fixture, 3, false, false);
+			AActor* Owner = Fixture.SpawnOwner();
+			FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+			UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+			if (!TestNotNull(FString::Printf(TEXT("Sequence instance, %s"), *Mode), Instance))
+			{
+				return false;
+			}
+
+			TestEqual(FString::Printf(TEXT("Multi Gate executed without the node instance, %s"), *Mode), FFlowTestFixture::GetNodeInstance(Instance, Graph.MultiGate) == nullptr, bLightweight);
+
+			for (int32 i = 0; i < 4; i++)
+			{
+				FFlowTestFixture::TriggerInput(Instance, Graph.MultiGate, UFlowNode::DefaultInputPin.PinName);
+			}
+			TestTrue(FString::Printf(TEXT("Sequence stops after the last output, %s"), *Mode), Graph.GetExecutions(Instance) == TArray<int32>({1, 1, 1}));
+
+			FFlowTestFixture::TriggerInput(Instance, Graph.MultiGate, TEXT("Reset"));
+			FFlowTestFixture::TriggerInput(Instance, Graph.MultiGate, UFlowNode::DefaultInputPin.PinName);
+			TestTrue(FString::Printf(TEXT("Sequence starts again after Reset, %s"), *Mode), Graph.GetExecutions(Instance) == TArray<int32>({2, 1, 1}));
+
+			FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+		}
+
+		// loop starts from the Start Index again after completing all outputs
+		{
+			const FMultiGateGraph Graph(Fixture, 3, false, true, 1);
+			AActor* Owner = Fixture.SpawnOwner();
+			FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+			UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+
+			for (int32 i = 0; i < 4; i++)
+			{
+				FFlowTestFixture::TriggerInput(Instance, Graph.MultiGate, UFlowNode::DefaultInputPin.PinName);
+			}
+			TestTrue(FString::Printf(TEXT("Loop from Start Index, %s"), *Mode), Graph.GetExecutions(Instance) == TArray<int32>({1, 2, 1}));
+
+			FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+		}
+
+		// random order triggers every output exactly once, lightweight state holds up to 32 outputs, node instance up to 64
+		for (const int32 NumOutputs : {UFlowNode_ExecutionMultiGate::MaxLightweightOutputs, UFlowNode_ExecutionMultiGate::MaxLightweightOutputs + 1, UFlowNode_ExecutionMultiGate::MaxOutputs})
+		{
+			const FString Context = FString::Printf(TEXT("%d outputs, %s"), NumOutputs, *Mode);
+
+			const FMultiGateGraph Graph(Fixture, NumOutputs, true, false);
+			AActor* Owner = Fixture.SpawnOwner();
+			FlowSubsystem->StartRootFlow(Owner, Graph.Template);
+			UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+
+			const bool bExpectLightweight = bLightweight && NumOutputs <= UFlowNode_ExecutionMultiGate::MaxLightweightOutputs;
+			TestEqual(FString::Printf(TEXT("Random Multi Gate executed without the node instance, %s"), *Context), FFlowTestFixture::GetNodeInstance(Instance, Graph.MultiGate) == nullptr, bExpectLightweight);
+
+			for (int32 i = 0; i <= NumOutputs; i++)
+			{
+				FFlowTestFixture::TriggerInput(Instance, Graph.MultiGate, UFlowNode::DefaultInputPin.PinName);
+			}
+
+			TArray<int32> Expected;
+			Expected.Init(1, NumOutputs);
+			TestTrue(FString::Printf(TEXT("Every random output triggered once, %s"), *Context), Graph.GetExecutions(Instance) == Expected);
+
+			FlowSubsystem->FinishRootFlow(Owner, Graph.Template, EFlowFinishPolicy::Keep);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,161 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowComponent.h"
+#include "FlowNotifyQueue.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowNotifyQueueTest
+{
+	constexpr int32 NumProducers = 4;
+	constexpr float DeltaTime = 0.05f;
+
+	/* Listener staying active in the Root Flow of the component */
+	UFlowAsset* CreateListenerTemplate(FFlowTestFixture& Fixture, UFlowTestNode_NotifyListener*& OutListener)
+	{
+		UFlowAsset* Template = Fixture.CreateTemplate();
+		UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+		OutListener = Fixture.AddNode<UFlowTestNode_NotifyListener>(Template);
+		FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, OutListener);
+		FFlowTestFixture::Compile(Template);
+		return Template;
+	}
+
+	TArray<FGameplayTag> GetReceivedNotifies(const UFlowComponent* Component, const UFlowTestNode_NotifyListener* Listener)
+	{
+		const UFlowTestNode_NotifyListener* ListenerInstance = FFlowTestFixture::GetNodeInstance(Component->GetRootFlowInstance(), Listener);
+		return ListenerInstance ? ListenerInstance->ReceivedNotifies : TArray<FGameplayTag>();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowNotifyQueueOrderTest, "Flow.NotifyQueue.Order", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowNotifyQueueOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowNotifyQueueTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	UFlowTestNode_NotifyListener* Listener = nullptr;
+	UFlowAsset* Template = CreateListenerTemplate(Fixture, Listener);
+
+	UFlowComponent* Component = Fixture.SpawnComponent();
+	FlowSubsystem->StartRootFlow(Component, Template);
+
+	const FGameplayTag NotifyA = FlowTestTags::NotifyA;
+	const FGameplayTag NotifyB = FlowTestTags::NotifyB;
+	const FFlowNotifyQueueRef NotifyQueue = FlowSubsystem->GetNotifyQueue();
+
+	// only the repeated notify is collapsed, notify sent again after another one isn't
+	for (const FGameplayTag& NotifyTag : {NotifyA, NotifyB, NotifyA, NotifyA, NotifyB})
+	{
+		NotifyQueue->QueueNotifyGraph(Component, NotifyTag);
+	}
+	TestEqual(TEXT("Queued notifies wait for the tick"), GetReceivedNotifies(Component, Listener).Num(), 0);
+
+	Fixture.Tick(DeltaTime);
+	TestTrue(TEXT("Queued notifies sent in order, repeated notify sent once"), GetReceivedNotifies(Component, Listener) == TArray<FGameplayTag>({NotifyA, NotifyB, NotifyA, NotifyB}));
+
+	// every thread keeps its own order, repeats are collapsed only within the thread
+	TArray<UE::Tasks::FTask> Producers;
+	for (int32 Producer = 0; Producer < NumProducers; Producer++)
+	{
+		Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [NotifyQueue, WeakComponent = TWeakObjectPtr<UFlowComponent>(Component), NotifyA, NotifyB]()
+		{
+			NotifyQueue->QueueNotifyGraph(WeakComponent, NotifyA);
+			NotifyQueue->QueueNotifyGraph(WeakComponent, NotifyA);
+			NotifyQueue->QueueNotifyGraph(WeakComponent, NotifyB);
+		}));
+	}
+	UE::Tasks::Wait(Producers);
+
+	Fixture.Tick(DeltaTime);
+	const TArray<FGameplayTag> Received = GetReceivedNotifies(Component, Listener);
+
+	// tasks might share a thread or interleave, but no thread sends B before its A
+	int32 NumA = 0;
+	int32 NumB = 0;
+	for (int32 Index = 4; Index < Received.Num(); Index++)
+	{
+		if (Received[Index] == NotifyA)
+		{
+			NumA++;
+		}
+		else
+		{
+			NumB++;
+		}
+
+		if (NumB > NumA)
+		{
+			AddError(TEXT("Notify sent before the notify queued earlier by the same thread"));
+			break;
+		}
+	}
+	TestTrue(TEXT("Notifies of every worker thread sent"), NumA > 0 && NumA == NumB && NumA <= NumProducers);
+
+	FlowSubsystem->FinishRootFlow(Component, Template, EFlowFinishPolicy::Keep);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowNotifyQueueDestroyedTargetsTest, "Flow.NotifyQueue.DestroyedTargets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowNotifyQueueDestroyedTargetsTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowNotifyQueueTest;
+
+	TUniquePtr<FFlowTestFixture> Fixture = MakeUnique<FFlowTestFixture>();
+	UFlowSubsystem* FlowSubsystem = Fixture->GetFlowSubsystem();
+	const FFlowNotifyQueueRef NotifyQueue = FlowSubsystem->GetNotifyQueue();
+
+	UFlowTestNode_NotifyListener* Listener = nullptr;
+	UFlowAsset* Template = CreateListenerTemplate(*Fixture, Listener);
+
+	UFlowComponent* Component = Fixture->SpawnComponent();
+	UFlowComponent* DestroyedComponent = Fixture->SpawnComponent();
+	FlowSubsystem->StartRootFlow(Component, Template);
+	FlowSubsystem->StartRootFlow(DestroyedComponent, Template);
+
+	// target destroyed before the tick is skipped, without affecting other notifies
+	NotifyQueue->QueueNotifyGraph(DestroyedComponent, FlowTestTags::NotifyA);
+	NotifyQueue->QueueNotifyGraph(Component, FlowTestTags::NotifyB);
+	const TWeakObjectPtr<UFlowComponent> WeakDestroyedComponent = DestroyedComponent;
+	DestroyedComponent->GetOwner()->Destroy();
+	TestFalse(TEXT("Target destroyed"), WeakDestroyedComponent.IsValid());
+
+	Fixture->Tick(DeltaTime);
+	TestTrue(TEXT("Notify of the existing target sent"), GetReceivedNotifies(Component, Listener) == TArray<FGameplayTag>({FlowTestTags::NotifyB}));
+	FlowSubsystem->FinishRootFlow(Component, Template, EFlowFinishPolicy::Keep);
+
+	// worker keeps queueing while the subsystem deinitializes, it holds only the queue
+	std::atomic<bool> bQueueing(true);
+	UE::Tasks::FTask Producer = UE::Tasks::Launch(UE_SOURCE_LOCATION, [NotifyQueue, WeakComponent = TWeakObjectPtr<UFlowComponent>(Component), &bQueueing]()
+	{
+		while (bQueueing)
+		{
+			NotifyQueue->QueueNotifyGraph(WeakComponent, FlowTestTags::NotifyA);
+		}
+	});
+
+	Fixture.Reset();
+	bQueueing = false;
+	Producer.Wait();
+
+	// notifies queued in the meantime are released with the last reference to the queue
+	TestTrue(TEXT("Queue closed by deinitializing the subsystem"), NotifyQueue->IsClosed());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
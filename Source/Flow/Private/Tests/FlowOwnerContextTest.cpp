@@ -0,0 +1,172 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowComponent.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowOwnerContextTest
+{
+	constexpr int32 NestingDepth = 3;
+
+	/* Chain of templates, every one except the last starts the next one with a Sub Graph node */
+	struct FNestedGraphs
+	{
+		UFlowAsset* Templates[NestingDepth] = {};
+		UFlowNode_SubGraph* SubGraphNodes[NestingDepth - 1] = {};
+		UFlowTestNode_Recorder* Leaf = nullptr;
+
+		explicit FNestedGraphs(FFlowTestFixture& Fixture)
+		{
+			for (int32 Depth = 0; Depth < NestingDepth; Depth++)
+			{
+				Templates[Depth] = Fixture.CreateTemplate();
+
+				// interface is resolved from the component owning the flow, regardless of project settings
+				FFlowTestFixture::SetExpectedOwnerClass(Templates[Depth], UFlowComponent::StaticClass());
+			}
+
+			for (int32 Depth = 0; Depth < NestingDepth; Depth++)
+			{
+				UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Templates[Depth]);
+				if (Depth < NestingDepth - 1)
+				{
+					SubGraphNodes[Depth] = Fixture.AddNode<UFlowNode_SubGraph>(Templates[Depth]);
+					FFlowTestFixture::SetSubGraphAsset(SubGraphNodes[Depth], Templates[Depth + 1]);
+					FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, SubGraphNodes[Depth], TEXT("Start"));
+				}
+				else
+				{
+					// deepest graph stays active, so the whole chain is kept running
+					Leaf = Fixture.AddNode<UFlowTestNode_Recorder>(Templates[Depth]);
+					Leaf->bStayActive = true;
+					FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Leaf);
+				}
+
+				FFlowTestFixture::Compile(Templates[Depth]);
+			}
+		}
+
+		/* Instances started by the Root Flow, ordered by depth */
+		TArray<UFlowAsset*> GetInstances(UFlowAsset* RootInstance) const
+		{
+			TArray<UFlowAsset*> Instances;
+			for (UFlowAsset* Instance = RootInstance; Instance; )
+			{
+				Instances.Add(Instance);
+
+				const int32 Depth = Instances.Num() - 1;
+				Instance = Depth < NestingDepth - 1 ? Instance->GetFlowInstance(FFlowTestFixture::GetNodeInstance(Instance, SubGraphNodes[Depth])).Get() : nullptr;
+			}
+			return Instances;
+		}
+
+		/* Node executed at given depth, it resolves the owner context of its instance */
+		UFlowNode* GetNodeInstance(const UFlowAsset* Instance, const int32 Depth) const
+		{
+			return Depth < NestingDepth - 1 ? static_cast<UFlowNode*>(FFlowTestFixture::GetNodeInstance(Instance, SubGraphNodes[Depth])) : FFlowTestFixture::GetNodeInstance(Instance, Leaf);
+		}
+	};
+
+	struct FOwner
+	{
+		AActor* Actor = nullptr;
+		UFlowComponent* FlowComponent = nullptr;
+		TArray<UFlowAsset*> Instances;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowOwnerContextSubGraphTest, "Flow.OwnerContext.SubGraphNesting", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowOwnerContextSubGraphTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowOwnerContextTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+	const FNestedGraphs Graphs(Fixture);
+
+	// the same templates run for two owners, every Sub Graph instance has to resolve the owner of its own Root Flow
+	FOwner Owners[2];
+	for (FOwner& Owner : Owners)
+	{
+		Owner.Actor = Fixture.SpawnOwner();
+		Owner.FlowComponent = NewObject<UFlowComponent>(Owner.Actor);
+
+		FlowSubsystem->StartRootFlow(Owner.FlowComponent, Graphs.Templates[0]);
+		Owner.Instances = Graphs.GetInstances(Fixture.GetRootInstance(Owner.FlowComponent));
+		if (!TestEqual(TEXT("Sub Graphs started by the Root Flow"), Owner.Instances.Num(), NestingDepth))
+		{
+			return false;
+		}
+	}
+
+	for (int32 OwnerIndex = 0; OwnerIndex < UE_ARRAY_COUNT(Owners); OwnerIndex++)
+	{
+		const FOwner& Owner = Owners[OwnerIndex];
+		const FOwner& OtherOwner = Owners[1 - OwnerIndex];
+
+		for (int32 Depth = 0; Depth < NestingDepth; Depth++)
+		{
+			const FString Context = FString::Printf(TEXT("owner %d, depth %d"), OwnerIndex, Depth);
+			const UFlowNode* Node = Graphs.GetNodeInstance(Owner.Instances[Depth], Depth);
+
+			TestTrue(FString::Printf(TEXT("Owner context cached at %s"), *Context), Owner.Instances[Depth]->IsOwnerContextCached());
+			TestEqual(FString::Printf(TEXT("Owner at %s"), *Context), Owner.Instances[Depth]->GetOwner(), static_cast<UObject*>(Owner.FlowComponent));
+
+			AActor* CachedActor = Node->TryGetRootFlowActorOwner();
+			TestNotNull(FString::Printf(TEXT("Cached actor owner at %s"), *Context), CachedActor);
+			TestEqual(FString::Printf(TEXT("Cached actor owner at %s"), *Context), CachedActor, Owner.Actor);
+			TestNotEqual(FString::Printf(TEXT("Actor owner of the other Root Flow at %s"), *Context), CachedActor, OtherOwner.Actor);
+
+			IFlowOwnerInterface* CachedInterface = Node->GetFlowOwnerInterface();
+			TestNotNull(FString::Printf(TEXT("Cached owner interface at %s"), *Context), CachedInterface);
+			TestTrue(FString::Printf(TEXT("Cached owner interface at %s"), *Context), CachedInterface == static_cast<IFlowOwnerInterface*>(Owner.FlowComponent));
+		}
+	}
+
+	// resolving the owner without the cache gives the same result
+	{
+		UFlowAsset* DeepestInstance = Owners[0].Instances.Last();
+		const UFlowNode* DeepestNode = Graphs.GetNodeInstance(DeepestInstance, NestingDepth - 1);
+
+		DeepestInstance->InvalidateOwnerContext();
+		TestFalse(TEXT("Owner context invalidated"), DeepestInstance->IsOwnerContextCached());
+		TestEqual(TEXT("Resolved actor owner"), DeepestNode->TryGetRootFlowActorOwner(), Owners[0].Actor);
+		TestTrue(TEXT("Resolved owner interface"), DeepestNode->GetFlowOwnerInterface() == static_cast<IFlowOwnerInterface*>(Owners[0].FlowComponent));
+
+		DeepestInstance->CacheOwnerContext();
+		TestTrue(TEXT("Owner context cached again"), DeepestInstance->IsOwnerContextCached());
+		TestEqual(TEXT("Cached actor owner after caching again"), DeepestNode->TryGetRootFlowActorOwner(), Owners[0].Actor);
+	}
+
+	// cache holds weak pointers, so destroyed owner is never returned, while flows of the other owner are unaffected
+	Owners[0].Actor->Destroy();
+	for (int32 Depth = 0; Depth < NestingDepth; Depth++)
+	{
+		TestNull(FString::Printf(TEXT("Destroyed actor owner at depth %d"), Depth), Graphs.GetNodeInstance(Owners[0].Instances[Depth], Depth)->TryGetRootFlowActorOwner());
+		TestEqual(FString::Printf(TEXT("Actor owner of the other Root Flow at depth %d"), Depth), Graphs.GetNodeInstance(Owners[1].Instances[Depth], Depth)->TryGetRootFlowActorOwner(), Owners[1].Actor);
+	}
+
+	// finishing the Root Flow deinitializes every Sub Graph instance
+	for (FOwner& Owner : Owners)
+	{
+		FlowSubsystem->FinishRootFlow(Owner.FlowComponent, Graphs.Templates[0], EFlowFinishPolicy::Keep);
+		for (int32 Depth = 0; Depth < NestingDepth; Depth++)
+		{
+			TestFalse(FString::Printf(TEXT("Owner context released at depth %d"), Depth), Owner.Instances[Depth]->IsOwnerContextCached());
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
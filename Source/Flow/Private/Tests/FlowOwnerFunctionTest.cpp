@@ -0,0 +1,73 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowOwnerFunctionParams.h"
+#include "FlowOwnerFunctionRef.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowOwnerFunctionTest
+{
+	constexpr int32 NumCalls = 200000;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowOwnerFunctionCallBenchmark, "Flow.Performance.OwnerFunctionCall", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFlowOwnerFunctionCallBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace FlowOwnerFunctionTest;
+
+	const TStrongObjectPtr<UFlowTestOwner> Owner(NewObject<UFlowTestOwner>(GetTransientPackage()));
+	const TStrongObjectPtr<UFlowOwnerFunctionParams> Params(NewObject<UFlowOwnerFunctionParams>(GetTransientPackage()));
+	const TArray<FName> OutputNames;
+
+	FFlowOwnerFunctionRef FunctionRef;
+	FunctionRef.FunctionName = GET_FUNCTION_NAME_CHECKED(UFlowTestOwner, CountCall);
+
+	// the same function called through the resolved reference, as CallOwnerFunction node does after the first execution
+	auto MeasureCalls = [&]() -> double
+	{
+		Owner->NumCalls = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumCalls; i++)
+		{
+			FunctionRef.CallFunction(*Owner, *Params, OutputNames);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1e9 / NumCalls;
+	};
+
+	FFlowOwnerFunctionCache::Reset();
+	if (!TestNotNull(TEXT("Function resolved without native binding"), FunctionRef.TryResolveFunction(*UFlowTestOwner::StaticClass(), *UFlowOwnerFunctionParams::StaticClass())))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Function without binding is called through reflection"), FunctionRef.NativeFunction == nullptr);
+
+	const double ReflectionNanoseconds = MeasureCalls();
+	TestEqual(TEXT("Calls through reflection"), Owner->NumCalls, NumCalls);
+
+	FLOW_REGISTER_OWNER_FUNCTION(UFlowTestOwner, CountCall, CountCall, UFlowOwnerFunctionParams);
+	FunctionRef.TryResolveFunction(*UFlowTestOwner::StaticClass(), *UFlowOwnerFunctionParams::StaticClass());
+	TestTrue(TEXT("Function with binding is called directly"), FunctionRef.NativeFunction != nullptr);
+
+	const double NativeNanoseconds = MeasureCalls();
+	TestEqual(TEXT("Calls through native binding"), Owner->NumCalls, NumCalls);
+
+	FFlowOwnerNativeFunctionRegistry::Unregister(UFlowTestOwner::StaticClass(), GET_FUNCTION_NAME_CHECKED(UFlowTestOwner, CountCall));
+
+	AddInfo(FString::Printf(TEXT("Owner function call: ProcessEvent %.1f ns, native binding %.1f ns, %d calls each"), ReflectionNanoseconds, NativeNanoseconds, NumCalls));
+	if (NativeNanoseconds > ReflectionNanoseconds)
+	{
+		AddWarning(TEXT("Native binding isn't faster than ProcessEvent"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
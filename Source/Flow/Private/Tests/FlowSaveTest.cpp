@@ -0,0 +1,251 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowSave.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowSaveTest
+{
+	const FString FirstWorld = TEXT("FirstWorld");
+	const FString SecondWorld = TEXT("SecondWorld");
+
+	// node data of the first world doesn't fit a single chunk
+	constexpr int32 LargeNodeDataSize = FFlowWorldSaveBlock::ChunkSize + FFlowWorldSaveBlock::ChunkSize / 2;
+
+	FFlowAssetSaveData MakeInstanceRecord(const FString& WorldName, const FString& InstanceName, const int32 NodeDataSize)
+	{
+		FFlowAssetSaveData AssetRecord;
+		AssetRecord.WorldName = WorldName;
+		AssetRecord.InstanceName = InstanceName;
+		AssetRecord.AssetData = {1, 2, 3};
+
+		FFlowNodeSaveData& NodeRecord = AssetRecord.NodeRecords.AddDefaulted_GetRef();
+		NodeRecord.NodeGuid = FGuid::NewGuid();
+		NodeRecord.NodeData.SetNumUninitialized(NodeDataSize);
+
+		// deterministic, but not trivially compressible
+		FRandomStream Random(NodeDataSize);
+		for (uint8& Byte : NodeRecord.NodeData)
+		{
+			Byte = static_cast<uint8>(Random.RandHelper(16));
+		}
+
+		return AssetRecord;
+	}
+
+	FFlowComponentSaveData MakeComponentRecord(const FString& WorldName, const FString& ActorName)
+	{
+		FFlowComponentSaveData ComponentRecord;
+		ComponentRecord.WorldName = WorldName;
+		ComponentRecord.ActorInstanceName = ActorName;
+		ComponentRecord.ComponentData = {4, 5, 6};
+		return ComponentRecord;
+	}
+
+	void MakeRecords(FFlowSaveGameRecords& OutRecords)
+	{
+		OutRecords.FlowInstances.Add(MakeInstanceRecord(FirstWorld, TEXT("LargeInstance"), LargeNodeDataSize));
+		OutRecords.FlowInstances.Add(MakeInstanceRecord(SecondWorld, TEXT("SmallInstance"), 64));
+		OutRecords.FlowInstances.Add(MakeInstanceRecord(FString(), TEXT("GlobalInstance"), 64));
+		OutRecords.FlowComponents.Add(MakeComponentRecord(FirstWorld, TEXT("Actor")));
+		OutRecords.FlowComponents.Add(MakeComponentRecord(SecondWorld, TEXT("Actor")));
+	}
+
+	const FFlowWorldSaveBlock* FindBlock(const FFlowSaveGameRecords& Records, const FString& WorldName)
+	{
+		return Records.WorldBlocks.FindByPredicate([&WorldName](const FFlowWorldSaveBlock& WorldBlock)
+		{
+			return WorldBlock.WorldName == WorldName;
+		});
+	}
+
+	bool HasSameRecords(const TArray<FFlowAssetSaveData>& A, const TArray<FFlowAssetSaveData>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (const FFlowAssetSaveData& Record : A)
+		{
+			const FFlowAssetSaveData* Other = B.FindByPredicate([&Record](const FFlowAssetSaveData& OtherRecord)
+			{
+				return OtherRecord.InstanceName == Record.InstanceName && OtherRecord.WorldName == Record.WorldName;
+			});
+
+			if (Other == nullptr || Other->AssetData != Record.AssetData || Other->NodeRecords.Num() != Record.NodeRecords.Num())
+			{
+				return false;
+			}
+
+			for (int32 i = 0; i < Record.NodeRecords.Num(); i++)
+			{
+				if (Other->NodeRecords[i].NodeGuid != Record.NodeRecords[i].NodeGuid || Other->NodeRecords[i].NodeData != Record.NodeRecords[i].NodeData)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowSaveCompressionRoundTripTest, "Flow.SaveGame.CompressionRoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowSaveCompressionRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowSaveTest;
+
+	FFlowSaveGameRecords Original;
+	MakeRecords(Original);
+
+	FFlowSaveGameRecords Records;
+	MakeRecords(Records);
+	Records.FlowInstances = Original.FlowInstances;
+
+	Records.PackWorldBlocks(NAME_Zlib);
+	TestEqual(TEXT("Instance records moved to blocks"), Records.FlowInstances.Num(), 0);
+	TestEqual(TEXT("Component records moved to blocks"), Records.FlowComponents.Num(), 0);
+	TestEqual(TEXT("Block per world, including records not bound to any world"), Records.WorldBlocks.Num(), 3);
+
+	if (const FFlowWorldSaveBlock* LargeBlock = FindBlock(Records, FirstWorld))
+	{
+		TestEqual(TEXT("Chunks of the large block"), LargeBlock->CompressedChunkSizes.Num(), FMath::DivideAndRoundUp(LargeBlock->UncompressedSize, FFlowWorldSaveBlock::ChunkSize));
+		TestTrue(TEXT("Large block spans multiple chunks"), LargeBlock->CompressedChunkSizes.Num() > 1);
+	}
+	else
+	{
+		AddError(TEXT("Block of the first world is missing"));
+	}
+
+	// only the requested world is decompressed
+	TestTrue(TEXT("Second world unpacked"), Records.UnpackWorldBlock(SecondWorld));
+	TestEqual(TEXT("Blocks left after unpacking second world"), Records.WorldBlocks.Num(), 2);
+	TestEqual(TEXT("Instance records of second world"), Records.FlowInstances.Num(), 1);
+	TestFalse(TEXT("Unpacking the same world again"), Records.UnpackWorldBlock(SecondWorld));
+
+	TestTrue(TEXT("First world unpacked"), Records.UnpackWorldBlock(FirstWorld));
+	TestTrue(TEXT("Global records unpacked"), Records.UnpackWorldBlock(FString()));
+	TestEqual(TEXT("No blocks left"), Records.WorldBlocks.Num(), 0);
+	TestTrue(TEXT("Instance records survive the round trip"), HasSameRecords(Records.FlowInstances, Original.FlowInstances));
+	TestEqual(TEXT("Component records survive the round trip"), Records.FlowComponents.Num(), Original.FlowComponents.Num());
+
+	// packing again merges new records with the block compressed earlier
+	{
+		FFlowSaveGameRecords Merged;
+		Merged.FlowInstances.Add(Original.FlowInstances[0]);
+		Merged.PackWorldBlocks(NAME_Zlib);
+		Merged.FlowInstances.Add(MakeInstanceRecord(FirstWorld, TEXT("LateInstance"), 64));
+		Merged.PackWorldBlocks(NAME_Zlib);
+
+		TestEqual(TEXT("Records of the same world share the block"), Merged.WorldBlocks.Num(), 1);
+		TestTrue(TEXT("Merged block unpacked"), Merged.UnpackWorldBlock(FirstWorld));
+		TestEqual(TEXT("Merged instance records"), Merged.FlowInstances.Num(), 2);
+	}
+
+	// SaveGame finds records of packed blocks, decompressing them on request
+	{
+		UFlowSaveGame* SaveGame = NewObject<UFlowSaveGame>(GetTransientPackage());
+		FFlowSaveGameRecords Packed;
+		MakeRecords(Packed);
+		Packed.PackWorldBlocks(NAME_Zlib);
+		SaveGame->SwapRecords(Packed);
+
+		const FFlowAssetSaveData* AssetRecord = SaveGame->FindInstanceRecord(FirstWorld, TEXT("LargeInstance"));
+		if (TestNotNull(TEXT("Instance record found in packed SaveGame"), AssetRecord))
+		{
+			TestEqual(TEXT("Node data of the unpacked record"), AssetRecord->NodeRecords[0].NodeData.Num(), LargeNodeDataSize);
+		}
+		TestNotNull(TEXT("Global record unpacked with the world"), SaveGame->FindInstanceRecord(FString(), TEXT("GlobalInstance")));
+		TestNotNull(TEXT("Component record found in packed SaveGame"), SaveGame->FindComponentRecord(FirstWorld, TEXT("Actor")));
+		TestEqual(TEXT("Second world stays packed"), SaveGame->WorldBlocks.Num(), 1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowSaveCorruptWorldBlockTest, "Flow.SaveGame.CorruptWorldBlock", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowSaveCorruptWorldBlockTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowSaveTest;
+
+	enum class ECorruption : uint8
+	{
+		MissingChunk,
+		ExtraChunk,
+		TrailingData,
+		TruncatedData,
+		LargerUncompressedSize,
+		NegativeUncompressedSize,
+		NegativeChunkSize
+	};
+
+	const TArray<ECorruption> Corruptions = {
+		ECorruption::MissingChunk,
+		ECorruption::ExtraChunk,
+		ECorruption::TrailingData,
+		ECorruption::TruncatedData,
+		ECorruption::LargerUncompressedSize,
+		ECorruption::NegativeUncompressedSize,
+		ECorruption::NegativeChunkSize
+	};
+
+	AddExpectedError(TEXT("Failed to decompress Flow records of world"), EAutomationExpectedErrorFlags::Contains, Corruptions.Num());
+
+	for (const ECorruption Corruption : Corruptions)
+	{
+		FFlowSaveGameRecords Records;
+		Records.FlowInstances.Add(MakeInstanceRecord(FirstWorld, TEXT("LargeInstance"), LargeNodeDataSize));
+		Records.PackWorldBlocks(NAME_Zlib);
+
+		if (Records.WorldBlocks.Num() != 1 || Records.WorldBlocks[0].CompressedChunkSizes.Num() < 2)
+		{
+			AddError(TEXT("Packed block doesn't span multiple chunks"));
+			return false;
+		}
+
+		FFlowWorldSaveBlock& WorldBlock = Records.WorldBlocks[0];
+		switch (Corruption)
+		{
+			case ECorruption::MissingChunk:
+				WorldBlock.CompressedData.SetNum(WorldBlock.CompressedData.Num() - WorldBlock.CompressedChunkSizes.Last());
+				WorldBlock.CompressedChunkSizes.Pop();
+				break;
+			case ECorruption::ExtraChunk:
+				WorldBlock.CompressedChunkSizes.Add(WorldBlock.CompressedChunkSizes.Last());
+				WorldBlock.CompressedData.Append(WorldBlock.CompressedData.GetData() + WorldBlock.CompressedData.Num() - WorldBlock.CompressedChunkSizes.Last(), WorldBlock.CompressedChunkSizes.Last());
+				break;
+			case ECorruption::TrailingData:
+				WorldBlock.CompressedData.Add(0);
+				break;
+			case ECorruption::TruncatedData:
+				WorldBlock.CompressedData.Pop();
+				break;
+			case ECorruption::LargerUncompressedSize:
+				WorldBlock.UncompressedSize += FFlowWorldSaveBlock::ChunkSize;
+				break;
+			case ECorruption::NegativeUncompressedSize:
+				WorldBlock.UncompressedSize = -1;
+				break;
+			case ECorruption::NegativeChunkSize:
+				WorldBlock.CompressedChunkSizes[0] = -WorldBlock.CompressedChunkSizes[0];
+				break;
+			default:
+				break;
+		}
+
+		const FString Context = FString::Printf(TEXT("corruption %d"), static_cast<int32>(Corruption));
+		TestFalse(FString::Printf(TEXT("Block rejected, %s"), *Context), Records.UnpackWorldBlock(FirstWorld));
+		TestEqual(FString::Printf(TEXT("Corrupted block discarded, %s"), *Context), Records.WorldBlocks.Num(), 0);
+		TestEqual(FString::Printf(TEXT("No records restored, %s"), *Context), Records.FlowInstances.Num(), 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
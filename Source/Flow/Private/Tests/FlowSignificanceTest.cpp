@@ -0,0 +1,221 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowComponent.h"
+#include "FlowSettings.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_Timer.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowSignificanceTest
+{
+	constexpr float ThrottledSignificance = 0.5f;
+	constexpr float ThrottledTimersInterval = 1.0f;
+	constexpr float DeltaTime = 0.05f;
+
+	/* Listener staying active in the Root Flow of the component, Recorder counts notifies passed by the listener */
+	struct FNotifyGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowTestNode_NotifyListener* Listener = nullptr;
+		UFlowTestNode_Recorder* Recorder = nullptr;
+
+		explicit FNotifyGraph(FFlowTestFixture& Fixture)
+		{
+			Template = Fixture.CreateTemplate();
+			UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+			Listener = Fixture.AddNode<UFlowTestNode_NotifyListener>(Template);
+			Recorder = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Listener);
+			FFlowTestFixture::Connect(Listener, UFlowNode::DefaultOutputPin.PinName, Recorder);
+			FFlowTestFixture::Compile(Template);
+		}
+
+		TArray<FGameplayTag> GetReceivedNotifies(const UFlowComponent* Component) const
+		{
+			const UFlowTestNode_NotifyListener* ListenerInstance = FFlowTestFixture::GetNodeInstance(Component->GetRootFlowInstance(), Listener);
+			return ListenerInstance ? ListenerInstance->ReceivedNotifies : TArray<FGameplayTag>();
+		}
+
+		int32 GetNumRecorded(const UFlowComponent* Component) const
+		{
+			const UFlowTestNode_Recorder* RecorderInstance = FFlowTestFixture::GetNodeInstance(Component->GetRootFlowInstance(), Recorder);
+			return RecorderInstance ? RecorderInstance->GetNumExecuted() : 0;
+		}
+	};
+
+	/* Timer properties are edited only in the editor, so the test sets them the way Details panel does */
+	void SetTimerProperty(UFlowNode_Timer* Timer, const FName& PropertyName, const float Value)
+	{
+		const FFloatProperty* Property = FindFProperty<FFloatProperty>(UFlowNode_Timer::StaticClass(), PropertyName);
+		Property->SetPropertyValue_InContainer(Timer, Value);
+	}
+
+	struct FTimerGraph
+	{
+		UFlowAsset* Template = nullptr;
+		UFlowTestNode_Recorder* Step = nullptr;
+		UFlowTestNode_Recorder* Completed = nullptr;
+
+		FTimerGraph(FFlowTestFixture& Fixture, const float CompletionTime, const float StepTime)
+		{
+			Template = Fixture.CreateTemplate();
+			UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+			UFlowNode_Timer* Timer = Fixture.AddNode<UFlowNode_Timer>(Template);
+			SetTimerProperty(Timer, TEXT("CompletionTime"), CompletionTime);
+			SetTimerProperty(Timer, TEXT("StepTime"), StepTime);
+			Step = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+			Completed = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+			FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Timer);
+			FFlowTestFixture::Connect(Timer, TEXT("Step"), Step);
+			FFlowTestFixture::Connect(Timer, TEXT("Completed"), Completed);
+			FFlowTestFixture::Compile(Template);
+		}
+
+		int32 GetSteps(const UFlowComponent* Component) const
+		{
+			const UFlowTestNode_Recorder* StepInstance = FFlowTestFixture::GetNodeInstance(Component->GetRootFlowInstance(), Step);
+			return StepInstance ? StepInstance->GetNumExecuted() : 0;
+		}
+
+		int32 GetCompleted(const UFlowComponent* Component) const
+		{
+			const UFlowTestNode_Recorder* CompletedInstance = FFlowTestFixture::GetNodeInstance(Component->GetRootFlowInstance(), Completed);
+			return CompletedInstance ? CompletedInstance->GetNumExecuted() : 0;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowThrottledNotifiesTest, "Flow.Significance.ThrottledNotifies", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowThrottledNotifiesTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowSignificanceTest;
+
+	const TGuardValue<float> SignificanceGuard(UFlowSettings::Get()->ThrottledSignificance, ThrottledSignificance);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+	const FNotifyGraph Graph(Fixture);
+
+	// the same notifies are sent to a significant component as a reference
+	UFlowComponent* ReferenceComponent = Fixture.SpawnComponent();
+	UFlowComponent* Component = Fixture.SpawnComponent();
+	Component->SetSignificance(0.0f);
+	if (!TestTrue(TEXT("Insignificant component throttled"), FlowSubsystem->IsOwnerThrottled(Component)))
+	{
+		return false;
+	}
+
+	FlowSubsystem->StartRootFlow(ReferenceComponent, Graph.Template);
+	FlowSubsystem->StartRootFlow(Component, Graph.Template);
+
+	const TArray<FGameplayTag> SentNotifies = {FlowTestTags::NotifyA, FlowTestTags::NotifyB, FlowTestTags::NotifyA};
+	for (const FGameplayTag& NotifyTag : SentNotifies)
+	{
+		ReferenceComponent->NotifyGraph(NotifyTag);
+		Component->NotifyGraph(NotifyTag);
+	}
+
+	TestTrue(TEXT("Reference component receives notifies immediately"), Graph.GetReceivedNotifies(ReferenceComponent) == SentNotifies);
+	TestEqual(TEXT("Notifies of throttled component deferred"), Graph.GetReceivedNotifies(Component).Num(), 0);
+
+	// deferred notifies are broadcast by the next tick, in the order they were sent
+	Fixture.Tick(DeltaTime);
+	TestTrue(TEXT("Deferred notifies received in order"), Graph.GetReceivedNotifies(Component) == SentNotifies);
+	TestEqual(TEXT("End state matches the reference"), Graph.GetNumRecorded(Component), Graph.GetNumRecorded(ReferenceComponent));
+
+	// removing throttling broadcasts deferred notifies without waiting for the tick
+	Component->NotifyGraph(FlowTestTags::NotifyB);
+	TestEqual(TEXT("Notify deferred again"), Graph.GetReceivedNotifies(Component).Num(), SentNotifies.Num());
+	Component->SetSignificance(1.0f);
+	TestFalse(TEXT("Significant component isn't throttled"), FlowSubsystem->IsOwnerThrottled(Component));
+	TestEqual(TEXT("Deferred notify received after removing throttling"), Graph.GetReceivedNotifies(Component).Num(), SentNotifies.Num() + 1);
+
+	// unregistered component drops its deferred notifies, they aren't broadcast in the middle of unregistering
+	Component->SetSignificance(0.0f);
+	Component->NotifyGraph(FlowTestTags::NotifyA);
+	Fixture.UnregisterComponent(Component);
+	TestFalse(TEXT("Throttling removed by unregistering"), FlowSubsystem->IsOwnerThrottled(Component));
+	TestEqual(TEXT("Deferred notify dropped while unregistering"), Graph.GetReceivedNotifies(Component).Num(), SentNotifies.Num() + 1);
+	Fixture.Tick(DeltaTime);
+	TestEqual(TEXT("Dropped notify isn't broadcast by the tick"), Graph.GetReceivedNotifies(Component).Num(), SentNotifies.Num() + 1);
+
+	// significance is kept by the component, so registering it again restores throttling
+	Fixture.RegisterComponent(Component);
+	TestTrue(TEXT("Throttling restored by registering"), FlowSubsystem->IsOwnerThrottled(Component));
+
+	FlowSubsystem->FinishRootFlow(ReferenceComponent, Graph.Template, EFlowFinishPolicy::Keep);
+	FlowSubsystem->FinishRootFlow(Component, Graph.Template, EFlowFinishPolicy::Keep);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowThrottledTimerTest, "Flow.Significance.ThrottledTimer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowThrottledTimerTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowSignificanceTest;
+
+	UFlowSettings* Settings = UFlowSettings::Get();
+	const TGuardValue<float> SignificanceGuard(Settings->ThrottledSignificance, ThrottledSignificance);
+	const TGuardValue<float> IntervalGuard(Settings->ThrottledTimersInterval, ThrottledTimersInterval);
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// steps of throttled Timer are executed in batches, but the flow ends in the same state as the reference
+	{
+		const FTimerGraph Graph(Fixture, 2.0f, 0.5f);
+		UFlowComponent* ReferenceComponent = Fixture.SpawnComponent();
+		UFlowComponent* Component = Fixture.SpawnComponent();
+		Component->SetSignificance(0.0f);
+
+		FlowSubsystem->StartRootFlow(ReferenceComponent, Graph.Template);
+		FlowSubsystem->StartRootFlow(Component, Graph.Template);
+
+		Fixture.Tick(DeltaTime, FMath::RoundToInt(0.75f / DeltaTime));
+		TestEqual(TEXT("Reference Timer step"), Graph.GetSteps(ReferenceComponent), 1);
+		TestEqual(TEXT("Throttled Timer step waits for the batch"), Graph.GetSteps(Component), 0);
+
+		Fixture.Tick(DeltaTime, FMath::RoundToInt(2.75f / DeltaTime));
+		TestEqual(TEXT("Reference Timer completed"), Graph.GetCompleted(ReferenceComponent), 1);
+		TestEqual(TEXT("Throttled Timer completed once"), Graph.GetCompleted(Component), 1);
+		TestEqual(TEXT("Steps match the reference"), Graph.GetSteps(Component), Graph.GetSteps(ReferenceComponent));
+
+		FlowSubsystem->FinishRootFlow(ReferenceComponent, Graph.Template, EFlowFinishPolicy::Keep);
+		FlowSubsystem->FinishRootFlow(Component, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	// expired Timer waiting for the batch is dropped by unregistering the component
+	{
+		const FTimerGraph Graph(Fixture, 0.5f, 0.0f);
+		UFlowComponent* Component = Fixture.SpawnComponent();
+		Component->SetSignificance(0.0f);
+		FlowSubsystem->StartRootFlow(Component, Graph.Template);
+
+		Fixture.Tick(DeltaTime, FMath::RoundToInt(0.75f / DeltaTime));
+		TestEqual(TEXT("Expired Timer waits for the batch"), Graph.GetCompleted(Component), 0);
+
+		Fixture.UnregisterComponent(Component);
+		TestEqual(TEXT("Deferred completion isn't executed while unregistering"), Graph.GetCompleted(Component), 0);
+
+		Fixture.Tick(DeltaTime, FMath::RoundToInt(2.0f * ThrottledTimersInterval / DeltaTime));
+		TestEqual(TEXT("Dropped completion isn't executed by the batch"), Graph.GetCompleted(Component), 0);
+
+		FlowSubsystem->FinishRootFlow(Component, Graph.Template, EFlowFinishPolicy::Keep);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,104 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Finish.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowSubGraphPoolingTest
+{
+	constexpr int32 NumActivations = 10;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowSubGraphPoolingTest, "Flow.SubGraph.Pooling", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowSubGraphPoolingTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowSubGraphPoolingTest;
+
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	// Sub Graph finishes right after recording its execution, so its instance goes back to the pool immediately
+	UFlowAsset* SubGraphTemplate = Fixture.CreateTemplate();
+	SubGraphTemplate->MaxPooledInstances = 1;
+	UFlowNode_Start* SubGraphStart = Fixture.AddNode<UFlowNode_Start>(SubGraphTemplate);
+	UFlowTestNode_Recorder* SubGraphRecorder = Fixture.AddNode<UFlowTestNode_Recorder>(SubGraphTemplate);
+	UFlowNode_Finish* SubGraphFinish = Fixture.AddNode<UFlowNode_Finish>(SubGraphTemplate);
+	FFlowTestFixture::Connect(SubGraphStart, UFlowNode::DefaultOutputPin.PinName, SubGraphRecorder);
+	FFlowTestFixture::Connect(SubGraphRecorder, UFlowNode::DefaultOutputPin.PinName, SubGraphFinish);
+	FFlowTestFixture::Compile(SubGraphTemplate);
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowNode_SubGraph* SubGraph = Fixture.AddNode<UFlowNode_SubGraph>(Template);
+	UFlowTestNode_Recorder* AfterSubGraph = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	FFlowTestFixture::SetSubGraphAsset(SubGraph, SubGraphTemplate);
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, SubGraph, TEXT("Start"));
+	FFlowTestFixture::Connect(SubGraph, TEXT("Finish"), AfterSubGraph);
+	FFlowTestFixture::Compile(Template);
+
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(Owner, Template);
+
+	UFlowAsset* Instance = Fixture.GetRootInstance(Owner);
+	if (!TestNotNull(TEXT("Root Flow instance"), Instance))
+	{
+		return false;
+	}
+
+	TArray<UFlowAsset*> PooledInstances = Fixture.GetPooledInstances(SubGraphTemplate);
+	if (!TestEqual(TEXT("Finished Sub Graph instance pooled"), PooledInstances.Num(), 1))
+	{
+		return false;
+	}
+
+	const TWeakObjectPtr<UFlowAsset> PooledInstance = PooledInstances[0];
+	const UFlowTestNode_Recorder* PooledRecorder = FFlowTestFixture::GetNodeInstance(PooledInstance.Get(), SubGraphRecorder);
+
+	// every activation reuses the same instance and its nodes, nothing is left behind by the finished Sub Graph
+	for (int32 Activation = 1; Activation <= NumActivations; Activation++)
+	{
+		const FString Context = FString::Printf(TEXT("activation %d"), Activation);
+		if (Activation > 1)
+		{
+			FFlowTestFixture::TriggerInput(Instance, SubGraph, TEXT("Start"));
+		}
+
+		PooledInstances = Fixture.GetPooledInstances(SubGraphTemplate);
+		TestEqual(FString::Printf(TEXT("Pool size, %s"), *Context), PooledInstances.Num(), 1);
+		TestTrue(FString::Printf(TEXT("Pooled instance reused, %s"), *Context), PooledInstances.Num() == 1 && PooledInstances[0] == PooledInstance.Get());
+		TestEqual(FString::Printf(TEXT("Pooled nodes reused, %s"), *Context), PooledRecorder->GetNumExecuted(), Activation);
+		TestEqual(FString::Printf(TEXT("Sub Graph output triggered, %s"), *Context), FFlowTestFixture::GetNodeInstance(Instance, AfterSubGraph)->GetNumExecuted(), Activation);
+
+		TestEqual(FString::Printf(TEXT("No Sub Flows left, %s"), *Context), FlowSubsystem->GetInstancedSubFlows().Num(), 0);
+		TestEqual(FString::Printf(TEXT("Pooled instance removed from the template, %s"), *Context), SubGraphTemplate->GetInstancesNum(), 0);
+		TestEqual(FString::Printf(TEXT("No active nodes in the pooled instance, %s"), *Context), PooledInstance->GetActiveNodes().Num(), 0);
+		TestEqual(FString::Printf(TEXT("No recorded nodes in the pooled instance, %s"), *Context), PooledInstance->GetRecordedNodes().Num(), 0);
+		TestNull(FString::Printf(TEXT("Pooled instance doesn't keep the owner, %s"), *Context), PooledInstance->GetOwner());
+	}
+
+	// finishing the Root Flow keeps the pool, it belongs to the Sub Graph asset
+	FlowSubsystem->FinishRootFlow(Owner, Template, EFlowFinishPolicy::Keep);
+	TestEqual(TEXT("Pool kept after finishing the Root Flow"), Fixture.GetPooledInstances(SubGraphTemplate).Num(), 1);
+
+	// ending world drops instances pooled by its flows, so nothing keeps them alive
+	FlowSubsystem->TeardownWorldFlows(Fixture.GetWorld());
+	TestEqual(TEXT("Pool emptied by the world teardown"), Fixture.GetPooledInstances(SubGraphTemplate).Num(), 0);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	TestFalse(TEXT("Pooled instance garbage collected"), PooledInstance.IsValid());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
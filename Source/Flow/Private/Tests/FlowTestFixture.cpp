@@ -0,0 +1,186 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Tests/FlowTestFixture.h"
+#include "FlowComponent.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+FFlowTestFixture::FFlowTestFixture()
+	: GameInstance(NewObject<UGameInstance>(GEngine))
+	, FlowSubsystem(nullptr)
+{
+	// creates the Game world and initializes subsystems, like starting a standalone game
+	GameInstance->InitializeStandalone();
+	FlowSubsystem = GameInstance->GetSubsystem<UFlowSubsystem>();
+}
+
+FFlowTestFixture::~FFlowTestFixture()
+{
+	UWorld* World = GameInstance->GetWorld();
+
+	// deinitializes the subsystem, which waits for pending saves
+	GameInstance->Shutdown();
+
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+UWorld* FFlowTestFixture::GetWorld() const
+{
+	return GameInstance->GetWorld();
+}
+
+AActor* FFlowTestFixture::SpawnOwner() const
+{
+	return GetWorld()->SpawnActor<AActor>();
+}
+
+UFlowComponent* FFlowTestFixture::SpawnComponent() const
+{
+	AActor* Owner = SpawnOwner();
+	UFlowComponent* Component = NewObject<UFlowComponent>(Owner);
+	Owner->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+
+	// world of the fixture doesn't begin play, so the owner is started like a spawned actor of the running game
+	Owner->DispatchBeginPlay();
+	return Component;
+}
+
+void FFlowTestFixture::RegisterComponent(UFlowComponent* Component) const
+{
+	FlowSubsystem->RegisterComponent(Component);
+}
+
+void FFlowTestFixture::UnregisterComponent(UFlowComponent* Component) const
+{
+	FlowSubsystem->UnregisterComponent(Component);
+}
+
+UFlowAsset* FFlowTestFixture::CreateTemplate()
+{
+	UFlowAsset* Template = NewObject<UFlowAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+	Templates.Emplace(Template);
+	return Template;
+}
+
+UFlowNode* FFlowTestFixture::AddNode(UFlowAsset* Template, const TSubclassOf<UFlowNode> NodeClass) const
+{
+	UFlowNode* Node = NewObject<UFlowNode>(Template, NodeClass, NAME_None, RF_Transient);
+	Node->SetGuid(FGuid::NewGuid());
+	Template->Nodes.Add(Node->GetGuid(), Node);
+	return Node;
+}
+
+void FFlowTestFixture::Connect(UFlowNode* FromNode, const FName& OutputPin, UFlowNode* ToNode, const FName& InputPin)
+{
+	const FConnectedPin Connection(ToNode->GetGuid(), InputPin);
+	if (FromNode->Connections.Contains(OutputPin))
+	{
+		FromNode->FanOutConnections.FindOrAdd(OutputPin).Pins.Add(Connection);
+	}
+	else
+	{
+		FromNode->Connections.Add(OutputPin, Connection);
+	}
+}
+
+void FFlowTestFixture::SetNumberedOutputPins(UFlowNode* Node, const int32 NumOutputs)
+{
+	Node->SetNumberedOutputPins(0, NumOutputs - 1);
+}
+
+void FFlowTestFixture::SetSubGraphAsset(UFlowNode_SubGraph* SubGraphNode, UFlowAsset* SubGraphTemplate)
+{
+	SubGraphNode->Asset = SubGraphTemplate;
+}
+
+void FFlowTestFixture::SetExpectedOwnerClass(UFlowAsset* Template, UClass* OwnerClass)
+{
+	Template->ExpectedOwnerClass = OwnerClass;
+}
+
+void FFlowTestFixture::Compile(UFlowAsset* Template)
+{
+	Template->CompileGraph();
+}
+
+#if WITH_EDITOR
+void FFlowTestFixture::InlineSubGraphs(UFlowAsset* Template)
+{
+	Template->InlineSubGraphs();
+}
+
+void FFlowTestFixture::RestoreInlinedSubGraphs(UFlowAsset* Template)
+{
+	Template->RestoreInlinedSubGraphs();
+}
+#endif
+
+UFlowAsset* FFlowTestFixture::GetRootInstance(const UObject* Owner) const
+{
+	const TSet<UFlowAsset*> Instances = FlowSubsystem->GetRootInstancesByOwner(Owner);
+	return Instances.Num() > 0 ? Instances.Array()[0] : nullptr;
+}
+
+void FFlowTestFixture::TriggerInput(UFlowAsset* Instance, const UFlowNode* TemplateNode, const FName& InputPin)
+{
+	const TArray<FFlowCompiledNode>& CompiledNodes = Instance->GetCompiledGraph().Nodes;
+	const int32 CompiledIndex = CompiledNodes.IndexOfByPredicate([TemplateNode](const FFlowCompiledNode& CompiledNode)
+	{
+		return CompiledNode.NodeGuid == TemplateNode->GetGuid();
+	});
+
+	Instance->TriggerInput(CompiledIndex, InputPin);
+}
+
+const TArray<int32>& FFlowTestFixture::GetLightweightNodeStates(const UFlowAsset* Instance)
+{
+	return Instance->LightweightNodeStates;
+}
+
+TArray<UFlowAsset*> FFlowTestFixture::GetPooledInstances(const UFlowAsset* Template) const
+{
+	TArray<UFlowAsset*> Instances;
+	if (const FFlowInstancePool* Pool = FlowSubsystem->PooledSubFlows.Find(Template))
+	{
+		for (const FFlowPooledInstance& PooledInstance : Pool->Instances)
+		{
+			Instances.Add(PooledInstance.Instance);
+		}
+	}
+	return Instances;
+}
+
+void FFlowTestFixture::Tick(const float DeltaTime, const int32 NumTicks) const
+{
+	for (int32 i = 0; i < NumTicks; i++)
+	{
+		FlowSubsystem->Tick(DeltaTime);
+	}
+}
+
+void FFlowTestFixture::CompletePendingSaves() const
+{
+	// every phase of the save queues the next one on the game thread
+	for (int32 Phase = 0; Phase < 8 && FlowSubsystem->IsSavingGame(); Phase++)
+	{
+		const TArray<UE::Tasks::FTask> PendingSaveTasks = FlowSubsystem->PendingSaveTasks;
+		UE::Tasks::Wait(PendingSaveTasks);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
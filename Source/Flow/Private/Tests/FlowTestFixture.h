@@ -0,0 +1,108 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowAsset.h"
+
+#include "Templates/SubclassOf.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class AActor;
+class UFlowComponent;
+class UFlowNode_SubGraph;
+class UFlowSubsystem;
+class UGameInstance;
+class UWorld;
+
+/**
+ * Standalone Game Instance with its own world and Flow Subsystem, for tests executing flows the way the game does
+ * Templates are assembled from node objects and compiled directly, without the editor graph
+ * Subsystem isn't ticked by the engine while the test runs, tests call Tick explicitly
+ */
+class FFlowTestFixture
+{
+public:
+	FFlowTestFixture();
+	~FFlowTestFixture();
+
+	UGameInstance* GetGameInstance() const { return GameInstance.Get(); }
+	UFlowSubsystem* GetFlowSubsystem() const { return FlowSubsystem; }
+	UWorld* GetWorld() const;
+
+	/* Owner of Root Flows placed in the world of the fixture */
+	AActor* SpawnOwner() const;
+
+	/* Flow Component added to a new owner, which begins play, so the component registers in the Flow Subsystem */
+	UFlowComponent* SpawnComponent() const;
+
+	/* Registration done by BeginPlay and EndPlay of the component */
+	void RegisterComponent(UFlowComponent* Component) const;
+	void UnregisterComponent(UFlowComponent* Component) const;
+
+	/* Transient template asset, kept alive until the fixture is destroyed */
+	UFlowAsset* CreateTemplate();
+
+	UFlowNode* AddNode(UFlowAsset* Template, const TSubclassOf<UFlowNode> NodeClass) const;
+
+	template <class T>
+	T* AddNode(UFlowAsset* Template) const
+	{
+		return CastChecked<T>(AddNode(Template, T::StaticClass()));
+	}
+
+	/* Output connected multiple times passes the signal in order of connecting */
+	static void Connect(UFlowNode* FromNode, const FName& OutputPin, UFlowNode* ToNode, const FName& InputPin = UFlowNode::DefaultInputPin.PinName);
+
+	/* Replaces output pins with pins named by their index, like nodes with numbered outputs */
+	static void SetNumberedOutputPins(UFlowNode* Node, const int32 NumOutputs);
+
+	/* Sub Graph node starting instance of given template */
+	static void SetSubGraphAsset(UFlowNode_SubGraph* SubGraphNode, UFlowAsset* SubGraphTemplate);
+
+	/* Overrides Expected Owner Class from project settings, which decides the Flow Owner Interface resolved for the owner */
+	static void SetExpectedOwnerClass(UFlowAsset* Template, UClass* OwnerClass);
+
+	/* Called after adding all nodes and connections, instances execute the compiled graph */
+	static void Compile(UFlowAsset* Template);
+
+#if WITH_EDITOR
+	/* Copies nodes of Sub Graph assets into the template, like cooking does, see UFlowSettings::MaxInlinedSubGraphNodes */
+	static void InlineSubGraphs(UFlowAsset* Template);
+
+	/* Removes inlined nodes, like saving the cooked package does */
+	static void RestoreInlinedSubGraphs(UFlowAsset* Template);
+#endif
+
+	/* Node instance created from given template node */
+	template <class T>
+	static T* GetNodeInstance(const UFlowAsset* Instance, const T* TemplateNode)
+	{
+		return Instance ? Instance->GetNode<T>(TemplateNode->GetGuid()) : nullptr;
+	}
+
+	UFlowAsset* GetRootInstance(const UObject* Owner) const;
+
+	/* Executes input of node created from given template node, including nodes executed without the node instance */
+	static void TriggerInput(UFlowAsset* Instance, const UFlowNode* TemplateNode, const FName& InputPin);
+
+	/* State values of nodes executed without the node instance, see UFlowSettings::bLightweightRouteNodes */
+	static const TArray<int32>& GetLightweightNodeStates(const UFlowAsset* Instance);
+
+	/* Finished Sub Graph instances waiting for reuse, see UFlowAsset::MaxPooledInstances */
+	TArray<UFlowAsset*> GetPooledInstances(const UFlowAsset* Template) const;
+
+	void Tick(const float DeltaTime, const int32 NumTicks = 1) const;
+
+	/* Waits for background tasks of SaveGameToSlotAsync and runs their game thread continuations */
+	void CompletePendingSaves() const;
+
+private:
+	TStrongObjectPtr<UGameInstance> GameInstance;
+	UFlowSubsystem* FlowSubsystem;
+
+	TArray<TStrongObjectPtr<UFlowAsset>> Templates;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,101 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Tests/FlowTestNodes.h"
+#include "FlowComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowTestNodes)
+
+#if WITH_DEV_AUTOMATION_TESTS
+namespace FlowTestTags
+{
+	UE_DEFINE_GAMEPLAY_TAG(NotifyA, "Flow.Test.NotifyA");
+	UE_DEFINE_GAMEPLAY_TAG(NotifyB, "Flow.Test.NotifyB");
+}
+#endif
+
+UFlowTestNode_Recorder::UFlowTestNode_Recorder(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bStayActive(false)
+{
+}
+
+void UFlowTestNode_Recorder::ExecuteInput(const FName& PinName)
+{
+	ExecutedInputs.Add(PinName);
+
+	if (!bStayActive)
+	{
+		TriggerFirstOutput(true);
+	}
+}
+
+UFlowTestNode_NotifyListener::UFlowTestNode_NotifyListener(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UFlowTestNode_NotifyListener::ExecuteInput(const FName& PinName)
+{
+	UFlowComponent* Component = Cast<UFlowComponent>(TryGetRootFlowObjectOwner());
+	if (Component && !ObservedComponent.IsValid())
+	{
+		ObservedComponent = Component;
+		Component->OnNotifyFromComponent.AddUObject(this, &UFlowTestNode_NotifyListener::OnNotify);
+	}
+}
+
+void UFlowTestNode_NotifyListener::Cleanup()
+{
+	if (ObservedComponent.IsValid())
+	{
+		ObservedComponent->OnNotifyFromComponent.RemoveAll(this);
+	}
+	ObservedComponent.Reset();
+
+	Super::Cleanup();
+}
+
+void UFlowTestNode_NotifyListener::OnNotify(UFlowComponent* Component, const FGameplayTag& NotifyTag)
+{
+	ReceivedNotifies.Add(NotifyTag);
+	TriggerFirstOutput(false);
+}
+
+UFlowTestNode_AsyncWork::UFlowTestNode_AsyncWork(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	InputPins.Add(FFlowPin(TEXT("Other")));
+	InputPins.Add(FFlowPin(TEXT("Finish")));
+}
+
+void UFlowTestNode_AsyncWork::ExecuteInput(const FName& PinName)
+{
+	if (PinName == TEXT("Finish"))
+	{
+		Finish();
+		return;
+	}
+
+	ExecutedInputs.Add(PinName);
+	LaunchedWorks.Add(LaunchAsyncWork(PinName, ExecutedInputs.Num(), [](const int32& NumExecuted)
+	{
+		return NumExecuted;
+	},
+	[this](int32&& Result)
+	{
+		CompletedResults.Add(Result);
+		TriggerFirstOutput(false);
+	}));
+}
+
+UFlowTestOwner::UFlowTestOwner(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, NumCalls(0)
+{
+}
+
+FName UFlowTestOwner::CountCall(UFlowOwnerFunctionParams* Params)
+{
+	NumCalls++;
+	return NAME_None;
+}
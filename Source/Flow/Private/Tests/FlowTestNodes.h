@@ -0,0 +1,95 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowOwnerInterface.h"
+#include "Nodes/FlowNode.h"
+#include "Nodes/FlowNode_AsyncBase.h"
+
+#include "GameplayTagContainer.h"
+#include "NativeGameplayTags.h"
+#include "FlowTestNodes.generated.h"
+
+class UFlowComponent;
+class UFlowOwnerFunctionParams;
+
+#if WITH_DEV_AUTOMATION_TESTS
+namespace FlowTestTags
+{
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(NotifyA);
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(NotifyB);
+}
+#endif
+
+/**
+ * Records inputs executed on the node instance, used by automation tests
+ * Finishes and triggers Out on every input, unless it's set to stay active
+ */
+UCLASS(NotBlueprintable, NotPlaceable, meta = (DisplayName = "Test Recorder"))
+class UFlowTestNode_Recorder : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+	UPROPERTY()
+	bool bStayActive;
+
+	TArray<FName> ExecutedInputs;
+
+	int32 GetNumExecuted() const { return ExecutedInputs.Num(); }
+
+protected:
+	virtual void ExecuteInput(const FName& PinName) override;
+};
+
+/**
+ * Records notifies of the Flow Component owning its Root Flow, used by automation tests
+ * Stays active after the input, triggers Out on every notify
+ */
+UCLASS(NotBlueprintable, NotPlaceable, meta = (DisplayName = "Test Notify Listener"))
+class UFlowTestNode_NotifyListener : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+	TArray<FGameplayTag> ReceivedNotifies;
+
+protected:
+	TWeakObjectPtr<UFlowComponent> ObservedComponent;
+
+	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void Cleanup() override;
+
+	void OnNotify(UFlowComponent* Component, const FGameplayTag& NotifyTag);
+};
+
+/**
+ * Launches async work on every input, except Finish, used by automation tests
+ * Work returns the number of inputs executed so far, completion records the result and triggers Out
+ */
+UCLASS(NotBlueprintable, NotPlaceable, meta = (DisplayName = "Test Async Work"))
+class UFlowTestNode_AsyncWork : public UFlowNode_AsyncBase
+{
+	GENERATED_UCLASS_BODY()
+
+	TArray<FName> ExecutedInputs;
+	TArray<int32> CompletedResults;
+
+	/* Finished once completion of the work is queued on the game thread */
+	TArray<UE::Tasks::FTask> LaunchedWorks;
+
+protected:
+	virtual void ExecuteInput(const FName& PinName) override;
+};
+
+/**
+ * Flow owner with a native owner function, used by automation tests calling owner functions
+ */
+UCLASS(NotBlueprintable, Transient)
+class UFlowTestOwner : public UObject, public IFlowOwnerInterface
+{
+	GENERATED_UCLASS_BODY()
+
+	int32 NumCalls;
+
+	UFUNCTION()
+	FName CountCall(UFlowOwnerFunctionParams* Params);
+};
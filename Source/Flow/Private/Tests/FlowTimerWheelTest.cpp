@@ -0,0 +1,288 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowTimerWheel.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowTimerWheelTest
+{
+	constexpr float DeltaSeconds = 1.0f / 60.0f;
+	constexpr int32 NumTicks = 140;
+	constexpr int32 FlushInterval = 30;
+
+	enum ETimer
+	{
+		NextTick,
+		ShortDelay,
+		MiddleDelay,
+		LongDelay,
+		Loop,
+		NumTimers
+	};
+
+	struct FWheelState
+	{
+		FFlowTimerWheel Wheel;
+		FFlowTimerHandle Handles[NumTimers];
+		int32 Calls[NumTimers] = {};
+
+		void SetTimers(const UObject* Owner)
+		{
+			Handles[NextTick] = Wheel.SetTimerForNextTick(Owner, MakeDelegate(NextTick));
+			Handles[ShortDelay] = Wheel.SetTimer(Owner, MakeDelegate(ShortDelay), 0.1f, false);
+			Handles[MiddleDelay] = Wheel.SetTimer(Owner, MakeDelegate(MiddleDelay), 0.7f, false);
+			Handles[LongDelay] = Wheel.SetTimer(Owner, MakeDelegate(LongDelay), 1.9f, false);
+			Handles[Loop] = Wheel.SetTimer(Owner, MakeDelegate(Loop), 0.25f, true);
+		}
+
+		FFlowTimerDelegate MakeDelegate(const int32 Timer)
+		{
+			return FFlowTimerDelegate::CreateLambda([this, Timer]()
+			{
+				Calls[Timer]++;
+			});
+		}
+	};
+
+	// wheel advanced in steps, Now is updated before the step so delegates can record the time of the call
+	struct FSteppedWheel
+	{
+		FFlowTimerWheel Wheel;
+		double Now = 0.0;
+
+		void AdvanceTo(const double TargetTime, const float MaxStep)
+		{
+			while (Now < TargetTime - UE_KINDA_SMALL_NUMBER)
+			{
+				const float Step = FMath::Min(MaxStep, static_cast<float>(TargetTime - Now));
+				Now += Step;
+				Wheel.Advance(Step);
+			}
+		}
+	};
+
+	constexpr double TickDuration = 1.0 / 60.0;
+
+	// tolerance of the call time, wheel calls delegates in the first tick after the expire time
+	constexpr double CallTimeTolerance = TickDuration + 1e-4;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowTimerWheelThrottlingTest, "Flow.TimerWheel.Throttling", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowTimerWheelThrottlingTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowTimerWheelTest;
+
+	const UObject* Owner = GetTransientPackage();
+
+	FWheelState Immediate;
+	Immediate.SetTimers(Owner);
+
+	FWheelState Throttled;
+	Throttled.Wheel.SetThrottled(Owner, true);
+	Throttled.SetTimers(Owner);
+
+	for (int32 Tick = 1; Tick <= NumTicks; Tick++)
+	{
+		Immediate.Wheel.Advance(DeltaSeconds);
+		Throttled.Wheel.Advance(DeltaSeconds);
+
+		if (Tick == FlushInterval / 2)
+		{
+			// expired timer waits for the flush, it's still active but has no remaining time
+			TestFalse(TEXT("Expired timer of not throttled owner is completed"), Immediate.Wheel.IsTimerActive(Immediate.Handles[ShortDelay]));
+			TestTrue(TEXT("Expired timer of throttled owner waits for the call"), Throttled.Wheel.IsTimerActive(Throttled.Handles[ShortDelay]));
+			TestEqual(TEXT("Remaining time of the deferred timer"), Throttled.Wheel.GetTimerRemaining(Throttled.Handles[ShortDelay]), 0.0f);
+			TestEqual(TEXT("Deferred call isn't executed before the flush"), Throttled.Calls[ShortDelay], 0);
+		}
+
+		if (Tick % FlushInterval == 0)
+		{
+			Throttled.Wheel.FlushThrottledTimers();
+		}
+	}
+
+	// deferred calls are executed while removing throttling
+	Throttled.Wheel.SetThrottled(Owner, false);
+
+	for (int32 Timer = 0; Timer < NumTimers; Timer++)
+	{
+		TestEqual(FString::Printf(TEXT("Number of calls of timer %d"), Timer), Throttled.Calls[Timer], Immediate.Calls[Timer]);
+		TestTrue(FString::Printf(TEXT("Timer %d active in both wheels or neither"), Timer), Throttled.Wheel.IsTimerActive(Throttled.Handles[Timer]) == Immediate.Wheel.IsTimerActive(Immediate.Handles[Timer]));
+	}
+
+	TestEqual(TEXT("Number of active timers"), Throttled.Wheel.GetNumTimers(), Immediate.Wheel.GetNumTimers());
+	TestTrue(TEXT("Remaining time of the looping timer"), FMath::IsNearlyEqual(Throttled.Wheel.GetTimerRemaining(Throttled.Handles[Loop]), Immediate.Wheel.GetTimerRemaining(Immediate.Handles[Loop]), UE_KINDA_SMALL_NUMBER));
+	TestEqual(TEXT("Looping timer calls"), Immediate.Calls[Loop], static_cast<int32>(NumTicks * DeltaSeconds / 0.25f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowTimerWheelCascadeTest, "Flow.TimerWheel.Cascade", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowTimerWheelCascadeTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowTimerWheelTest;
+
+	struct FCascadeCase
+	{
+		const TCHAR* Name;
+		float Delay;
+		float MaxStep;
+	};
+
+	// delays counted in ticks: level 1 starts at 256 ticks, level 2 at 16384, level 3 at 2^20 and the wheel range ends at 2^26
+	const FCascadeCase Cases[] = {
+		{TEXT("Level 1"), 300.0f * TickDuration, 1.0f / 60.0f},
+		{TEXT("Level 2"), 20010.0f * TickDuration, 0.5f},
+		{TEXT("Level 3"), 5.0f * 3600.0f, 1.0f},
+		{TEXT("Beyond wheel range"), 14.0f * 24.0f * 3600.0f, 60.0f}
+	};
+
+	for (const FCascadeCase& Case : Cases)
+	{
+		FSteppedWheel Stepped;
+		int32 Calls = 0;
+		double CallTime = -1.0;
+
+		const FFlowTimerHandle Handle = Stepped.Wheel.SetTimer(nullptr, FFlowTimerDelegate::CreateLambda([&Stepped, &Calls, &CallTime]()
+		{
+			Calls++;
+			CallTime = Stepped.Now;
+		}), Case.Delay, false);
+
+		// remaining time is exact while the timer moves between levels
+		Stepped.AdvanceTo(Case.Delay * 0.5, Case.MaxStep);
+		TestTrue(FString::Printf(TEXT("%s: remaining time halfway"), Case.Name), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), Case.Delay * 0.5f, Case.Delay * 1e-6f + 1e-3f));
+
+		Stepped.AdvanceTo(Case.Delay - 2.0 * TickDuration, Case.MaxStep);
+		TestEqual(FString::Printf(TEXT("%s: not called before the expire time"), Case.Name), Calls, 0);
+		TestTrue(FString::Printf(TEXT("%s: remaining time before the call"), Case.Name), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), static_cast<float>(2.0 * TickDuration), 1e-3f));
+
+		Stepped.AdvanceTo(Case.Delay + 2.0 * TickDuration, 1.0f / 60.0f);
+		TestEqual(FString::Printf(TEXT("%s: called once"), Case.Name), Calls, 1);
+		TestTrue(FString::Printf(TEXT("%s: called in the tick of the expire time"), Case.Name), CallTime >= Case.Delay - 1e-3 && CallTime <= Case.Delay + CallTimeTolerance);
+		TestFalse(FString::Printf(TEXT("%s: completed timer"), Case.Name), Stepped.Wheel.IsTimerActive(Handle));
+		TestEqual(FString::Printf(TEXT("%s: no timers left"), Case.Name), Stepped.Wheel.GetNumTimers(), 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowTimerWheelCascadeLoopTest, "Flow.TimerWheel.CascadeLoop", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowTimerWheelCascadeLoopTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowTimerWheelTest;
+
+	// every cycle is rescheduled to level 1, then cascaded to level 0
+	{
+		constexpr float Rate = 5.0f;
+
+		FSteppedWheel Stepped;
+		TArray<double> CallTimes;
+		const FFlowTimerHandle Handle = Stepped.Wheel.SetTimer(nullptr, FFlowTimerDelegate::CreateLambda([&Stepped, &CallTimes]()
+		{
+			CallTimes.Add(Stepped.Now);
+		}), Rate, true);
+
+		Stepped.AdvanceTo(62.0, 1.0f / 60.0f);
+		TestEqual(TEXT("Level 1 loop calls"), CallTimes.Num(), 12);
+		for (int32 i = 0; i < CallTimes.Num(); i++)
+		{
+			const double ExpectedTime = (i + 1) * Rate;
+			TestTrue(FString::Printf(TEXT("Level 1 loop call %d keeps the original schedule"), i), CallTimes[i] >= ExpectedTime - 1e-3 && CallTimes[i] <= ExpectedTime + CallTimeTolerance);
+		}
+		TestTrue(TEXT("Level 1 loop remaining time"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), 3.0f, 1e-3f));
+	}
+
+	// single large step fires every cycle it covers
+	{
+		int32 Calls = 0;
+		FFlowTimerWheel Wheel;
+		const FFlowTimerHandle Handle = Wheel.SetTimer(nullptr, FFlowTimerDelegate::CreateLambda([&Calls]()
+		{
+			Calls++;
+		}), 5.0f, true);
+
+		Wheel.Advance(61.0f);
+		TestEqual(TEXT("Loop calls within a single step"), Calls, 12);
+		TestTrue(TEXT("Loop remaining time after a single step"), FMath::IsNearlyEqual(Wheel.GetTimerRemaining(Handle), 4.0f, 1e-3f));
+	}
+
+	// every cycle is rescheduled to level 2
+	{
+		constexpr float Rate = 300.0f;
+
+		FSteppedWheel Stepped;
+		TArray<double> CallTimes;
+		const FFlowTimerHandle Handle = Stepped.Wheel.SetTimer(nullptr, FFlowTimerDelegate::CreateLambda([&Stepped, &CallTimes]()
+		{
+			CallTimes.Add(Stepped.Now);
+		}), Rate, true);
+
+		Stepped.AdvanceTo(1000.0, 1.0f / 60.0f);
+		TestEqual(TEXT("Level 2 loop calls"), CallTimes.Num(), 3);
+		for (int32 i = 0; i < CallTimes.Num(); i++)
+		{
+			const double ExpectedTime = (i + 1) * Rate;
+			TestTrue(FString::Printf(TEXT("Level 2 loop call %d keeps the original schedule"), i), CallTimes[i] >= ExpectedTime - 1e-3 && CallTimes[i] <= ExpectedTime + CallTimeTolerance);
+		}
+		TestTrue(TEXT("Level 2 loop remaining time"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), 200.0f, 1e-2f));
+		TestTrue(TEXT("Level 2 loop elapsed time"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerElapsed(Handle), 100.0f, 1e-2f));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowTimerWheelPauseAcrossCascadesTest, "Flow.TimerWheel.PauseAcrossCascades", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowTimerWheelPauseAcrossCascadesTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowTimerWheelTest;
+
+	const UObject* Owner = GetTransientPackage();
+	constexpr float Delay = 20010.0f * static_cast<float>(TickDuration);
+
+	FSteppedWheel Stepped;
+	int32 Calls = 0;
+	double CallTime = -1.0;
+	const FFlowTimerHandle Handle = Stepped.Wheel.SetTimer(Owner, FFlowTimerDelegate::CreateLambda([&Stepped, &Calls, &CallTime]()
+	{
+		Calls++;
+		CallTime = Stepped.Now;
+	}), Delay, false);
+
+	// timer of level 2 is paused, while the wheel cascades other levels
+	Stepped.AdvanceTo(100.0, 0.5f);
+	Stepped.Wheel.SetTimeDilation(Owner, 0.0f);
+	const float PausedRemaining = Delay - 100.0f;
+	TestTrue(TEXT("Remaining time after pausing"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), PausedRemaining, 1e-3f));
+
+	Stepped.AdvanceTo(1100.0, 0.5f);
+	TestEqual(TEXT("Paused timer isn't called"), Calls, 0);
+	TestTrue(TEXT("Paused timer stays active"), Stepped.Wheel.IsTimerActive(Handle));
+	TestTrue(TEXT("Remaining time doesn't change while paused"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), PausedRemaining, 1e-3f));
+
+	// resumed at half speed, so the remaining owner's time takes twice as long and the timer lands on a different level
+	Stepped.Wheel.SetTimeDilation(Owner, 0.5f);
+	TestTrue(TEXT("Remaining time after resuming"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), PausedRemaining, 1e-3f));
+
+	const double ResumedExpireTime = 1100.0 + PausedRemaining / 0.5;
+	Stepped.AdvanceTo(1100.0 + PausedRemaining, 0.5f);
+	TestTrue(TEXT("Remaining time of dilated timer"), FMath::IsNearlyEqual(Stepped.Wheel.GetTimerRemaining(Handle), PausedRemaining * 0.5f, 1e-3f));
+
+	Stepped.AdvanceTo(ResumedExpireTime - 2.0 * TickDuration, 0.5f);
+	TestEqual(TEXT("Resumed timer isn't called before the expire time"), Calls, 0);
+
+	Stepped.AdvanceTo(ResumedExpireTime + 2.0 * TickDuration, 1.0f / 60.0f);
+	TestEqual(TEXT("Resumed timer called once"), Calls, 1);
+	TestTrue(TEXT("Resumed timer called in the tick of the expire time"), CallTime >= ResumedExpireTime - 1e-3 && CallTime <= ResumedExpireTime + CallTimeTolerance);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,66 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowMessageLog.h"
+#include "FlowSettings.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowUnreachableNodesValidationTest, "Flow.UnreachableNodes.Validation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFlowUnreachableNodesValidationTest::RunTest(const FString& Parameters)
+{
+	FFlowTestFixture Fixture;
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowTestNode_Recorder* Reached = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	UFlowTestNode_Recorder* Unreachable = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	UFlowTestNode_Recorder* UnreachableChild = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+
+	// nodes connected only to each other can't be reached either
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Reached);
+	FFlowTestFixture::Connect(Unreachable, UFlowNode::DefaultOutputPin.PinName, UnreachableChild);
+	FFlowTestFixture::Compile(Template);
+
+	TArray<FGuid> UnreachableNodes;
+	Template->GetUnreachableNodes(UnreachableNodes);
+	TestEqual(TEXT("Number of unreachable nodes"), UnreachableNodes.Num(), 2);
+	TestTrue(TEXT("Disconnected node is unreachable"), UnreachableNodes.Contains(Unreachable->GetGuid()));
+	TestTrue(TEXT("Node connected to unreachable node is unreachable"), UnreachableNodes.Contains(UnreachableChild->GetGuid()));
+
+	// warning is reported regardless of stripping, only its message depends on the setting
+	for (const bool bStripUnreachableNodes : {false, true})
+	{
+		const TGuardValue<bool> StripGuard(UFlowSettings::Get()->bStripUnreachableNodesOnCook, bStripUnreachableNodes);
+		const FString Context = bStripUnreachableNodes ? TEXT("stripping enabled") : TEXT("stripping disabled");
+
+		FFlowMessageLog MessageLog;
+		const EDataValidationResult Result = Template->ValidateAsset(MessageLog);
+		TestTrue(FString::Printf(TEXT("Unreachable nodes don't invalidate the asset, %s"), *Context), Result == EDataValidationResult::Valid);
+
+		int32 NumWarnings = 0;
+		for (const TSharedRef<FTokenizedMessage>& Message : MessageLog.Messages)
+		{
+			if (Message->GetSeverity() == EMessageSeverity::Warning)
+			{
+				NumWarnings++;
+
+				const FString MessageText = Message->ToText().ToString();
+				TestTrue(FString::Printf(TEXT("Warning about unreachable node, %s"), *Context), MessageText.Contains(TEXT("can't be reached from any entry node")));
+				TestTrue(FString::Printf(TEXT("Warning mentions removing node only if it's removed, %s"), *Context), MessageText.Contains(TEXT("removed from cooked asset")) == bStripUnreachableNodes);
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("Warning per unreachable node, %s"), *Context), NumWarnings, UnreachableNodes.Num());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -0,0 +1,50 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Tests/FlowTestFixture.h"
+#include "Tests/FlowTestNodes.h"
+
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowWorldTeardownTimersTest, "Flow.Subsystem.WorldTeardownTimers", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFlowWorldTeardownTimersTest::RunTest(const FString& Parameters)
+{
+	FFlowTestFixture Fixture;
+	UFlowSubsystem* FlowSubsystem = Fixture.GetFlowSubsystem();
+
+	UFlowAsset* Template = Fixture.CreateTemplate();
+	UFlowNode_Start* Start = Fixture.AddNode<UFlowNode_Start>(Template);
+	UFlowTestNode_Recorder* Recorder = Fixture.AddNode<UFlowTestNode_Recorder>(Template);
+	Recorder->bStayActive = true;
+	FFlowTestFixture::Connect(Start, UFlowNode::DefaultOutputPin.PinName, Recorder);
+	FFlowTestFixture::Compile(Template);
+
+	// Root Flow of the destroyed owner is still active when the world ends
+	AActor* DestroyedOwner = Fixture.SpawnOwner();
+	AActor* Owner = Fixture.SpawnOwner();
+	FlowSubsystem->StartRootFlow(DestroyedOwner, Template);
+	FlowSubsystem->StartRootFlow(Owner, Template);
+	DestroyedOwner->Destroy();
+
+	FFlowTimerWheel& TimerWheel = FlowSubsystem->GetTimerWheel();
+	const FFlowTimerHandle OwnerTimer = TimerWheel.SetTimer(Owner, FFlowTimerDelegate::CreateLambda([]() {}), 1.0f, false);
+	FFlowTimerHandle OwnerlessTimer = TimerWheel.SetTimer(nullptr, FFlowTimerDelegate::CreateLambda([]() {}), 1.0f, false);
+
+	// timers are cleared only for owners placed in the ending world
+	FlowSubsystem->TeardownWorldFlows(Fixture.GetWorld());
+	TestNull(TEXT("Root Flow finished by the world teardown"), Fixture.GetRootInstance(Owner));
+	TestFalse(TEXT("Timer of the world owner cleared"), TimerWheel.IsTimerActive(OwnerTimer));
+	TestTrue(TEXT("Timer without owner kept"), TimerWheel.IsTimerActive(OwnerlessTimer));
+
+	TimerWheel.ClearTimer(OwnerlessTimer);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "FlowCompiledGraph.h"
 #include "FlowSave.h"
 #include "FlowTypes.h"
 #include "Nodes/FlowNode.h"
@@ -11,8 +12,10 @@
 #endif
 
 #include "UObject/ObjectKey.h"
+#include "UObject/WeakInterfacePtr.h"
 #include "FlowAsset.generated.h"
 
+class IFlowOwnerInterface;
 class UFlowNode_CustomOutput;
 class UFlowNode_CustomInput;
 class UFlowNode_SubGraph;
@@ -39,6 +42,31 @@ DECLARE_DELEGATE(FFlowGraphEvent);
 
 #endif
 
+// Node copied from the Sub Graph asset into the parent asset while cooking, see UFlowSettings::MaxInlinedSubGraphNodes
+USTRUCT()
+struct FLOW_API FFlowInlinedNode
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Sub Graph node stays in the parent graph, it routes signals from and to inlined nodes
+	UPROPERTY()
+	FGuid SubGraphNodeGuid;
+
+	// Guid of the node in the Sub Graph asset
+	UPROPERTY()
+	FGuid SourceNodeGuid;
+
+	FFlowInlinedNode()
+	{
+	}
+
+	FFlowInlinedNode(const FGuid& InSubGraphNodeGuid, const FGuid& InSourceNodeGuid)
+		: SubGraphNodeGuid(InSubGraphNodeGuid)
+		, SourceNodeGuid(InSourceNodeGuid)
+	{
+	}
+};
+
 /**
  * Single asset containing flow nodes.
  */
@@ -49,6 +77,7 @@ class FLOW_API UFlowAsset : public UObject
 
 public:	
 	friend class UFlowNode;
+	friend struct FFlowLightweightNodeContext;
 	friend class UFlowNode_CustomOutput;
 	friend class UFlowNode_SubGraph;
 	friend class UFlowSubsystem;
@@ -57,6 +86,10 @@ public:
 	friend class FFlowNode_SubGraphDetails;
 	friend class UFlowGraphSchema;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FFlowTestFixture;
+#endif
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow Asset")
 	FGuid AssetGuid;
 
@@ -65,9 +98,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow Asset")
 	bool bWorldBound;
 
+	// Finished instances created by Sub Graph nodes are kept for reuse, up to this number, 0 disables pooling
+	// Useful for short graphs activated frequently, as reusing instance skips creating the asset and node objects
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sub Graph", meta = (ClampMin = 0))
+	int32 MaxPooledInstances;
+
 //////////////////////////////////////////////////////////////////////////
 // Graph
 
+	// UObject
+	virtual void Serialize(FArchive& Ar) override;
+	// --
+
 #if WITH_EDITOR
 	friend class UFlowGraph;
 
@@ -76,6 +118,8 @@ public:
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	virtual void PostLoad() override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext) override;
 	// --
 
 	virtual EDataValidationResult ValidateAsset(FFlowMessageLog& MessageLog);
@@ -85,6 +129,11 @@ public:
 
 	static FString ValidationError_NodeClassNotAllowed;
 	static FString ValidationError_NullNodeInstance;
+	static FString ValidationWarning_UnreachableNode;
+	static FString ValidationWarning_UnreachableNodeStripped;
+
+	// Returns nodes that can't be reached from any entry node, these are removed from cooked asset if UFlowSettings::bStripUnreachableNodesOnCook is enabled
+	void GetUnreachableNodes(TArray<FGuid>& OutNodeGuids) const;
 
 protected:
 	bool CanFlowNodeClassBeUsedByFlowAsset(const UClass& FlowNodeClass) const;
@@ -127,6 +176,40 @@ private:
 	UPROPERTY()
 	TMap<FGuid, UFlowNode*> Nodes;
 
+	// Index-based connections used at runtime, compiled while saving the asset
+	// Serialized by the asset instead of being a property, so instances don't copy it from the template
+	FFlowCompiledGraph CompiledGraph;
+
+	// Set on cooked asset, its nodes don't keep connections as signals are passed through the compiled graph
+	UPROPERTY()
+	bool bNodeConnectionsStripped;
+
+	// Nodes of small Sub Graphs copied into this asset while cooking
+	UPROPERTY()
+	TMap<FGuid, FFlowInlinedNode> InlinedNodes;
+
+#if WITH_EDITOR
+	// Unreachable nodes removed from Nodes while cooking, restored after saving the package
+	TMap<FGuid, UFlowNode*> CookStrippedNodes;
+
+	// Sub Graph nodes which assets were inlined while cooking, restored after saving the package
+	TArray<UFlowNode_SubGraph*> CookInlinedSubGraphs;
+
+	// Node connections removed from cooked nodes, restored after saving the package
+	TMap<FGuid, TMap<FName, FConnectedPin>> CookStrippedConnections;
+	TMap<FGuid, TMap<FName, FConnectedPins>> CookStrippedFanOutConnections;
+
+	void StripUnreachableNodes();
+	void RestoreStrippedNodes();
+
+	void StripNodeConnections();
+	void RestoreNodeConnections();
+
+	bool CanInlineSubGraph(const UFlowAsset& SubGraphAsset, const int32 MaxNodes) const;
+	void InlineSubGraphs();
+	void RestoreInlinedSubGraphs();
+#endif
+
 #if WITH_EDITORONLY_DATA
 protected:
 	/**
@@ -157,7 +240,23 @@ public:
 	void HarvestNodeConnections();
 #endif
 
+	// Rebuilds the compiled graph from node connections
+	void CompileGraph();
+
+	// Instances use the graph compiled on the template asset
+	const FFlowCompiledGraph& GetCompiledGraph() const { return TemplateAsset ? TemplateAsset->CompiledGraph : CompiledGraph; }
+
+	// Nodes of cooked asset read their connections from the compiled graph
+	bool AreNodeConnectionsStripped() const { return bNodeConnectionsStripped; }
+
 	const TMap<FGuid, UFlowNode*>& GetNodes() const { return Nodes; }
+
+	// Cooked asset might contain nodes copied from Sub Graph assets, these aren't entry points or outputs of this asset
+	bool IsInlinedNode(const UFlowNode* Node) const { return InlinedNodes.Num() > 0 && InlinedNodes.Contains(Node->GetGuid()); }
+	const FFlowInlinedNode* FindInlinedNode(const FGuid& NodeGuid) const { return InlinedNodes.Find(NodeGuid); }
+
+	// Returns Sub Graph node that executes given inlined node
+	UFlowNode_SubGraph* GetInlinedSubGraphNode(const UFlowNode* Node) const;
 	UFlowNode* GetNode(const FGuid& Guid) const { return Nodes.FindRef(Guid); }
 
 	template <class T>
@@ -192,6 +291,9 @@ public:
 	}
 
 protected:
+	// Resolves final targets of compiled edges leading to chains of pure pass-through nodes
+	void CollapsePassThroughNodes();
+
 	template <class T>
 	void GetNodesInExecutionOrder_Recursive(UFlowNode* Node, TSet<TObjectKey<UFlowNode>>& IteratedNodes, TArray<T*>& OutNodes)
 	{
@@ -233,10 +335,16 @@ protected:
 //////////////////////////////////////////////////////////////////////////
 // Instances of the template asset
 
+public:
+	// Cooked template and its nodes are loaded as a single GC cluster, as templates don't change during gameplay
+	// Clustered template doesn't keep its instances alive, Flow Subsystem references every instance on its own
+	virtual bool CanBeClusterRoot() const override;
+
 private:
-	// Original object holds references to instances
-	UPROPERTY(Transient)
-	TArray<UFlowAsset*> ActiveInstances;
+	// Original object tracks its instances, but doesn't keep them alive
+	// Weak pointers, as template might be a GC cluster root and its references aren't traced the usual way
+	// Flow Subsystem holds every instance, so entry goes stale only if instance has been destroyed without calling RemoveInstance
+	TArray<TWeakObjectPtr<UFlowAsset>> ActiveInstances;
 
 #if WITH_EDITORONLY_DATA
 	TWeakObjectPtr<UFlowAsset> InspectedInstance;
@@ -291,6 +399,24 @@ protected:
 	// Flow Asset instances created by SubGraph nodes placed in the current graph
 	TMap<TWeakObjectPtr<UFlowNode_SubGraph>, TWeakObjectPtr<UFlowAsset>> ActiveSubGraphs;
 
+	// Node instances in order of the compiled graph
+	TArray<UFlowNode*> CompiledNodes;
+
+	// Template node executed without the node instance, see UFlowSettings::bLightweightRouteNodes
+	struct FLightweightNode
+	{
+		const UFlowNode* Template = nullptr;
+		int32 StateOffset = 0;
+		int32 StateSize = 0;
+	};
+
+	// In order of the compiled graph, empty if there are no lightweight nodes
+	TArray<FLightweightNode> LightweightNodes;
+
+	// State values of all lightweight nodes
+	UPROPERTY(SaveGame)
+	TArray<int32> LightweightNodeStates;
+
 	// Optional entry points to the graph, similar to blueprint Custom Events
 	UPROPERTY()
 	TSet<UFlowNode_CustomInput*> CustomInputNodes;
@@ -308,10 +434,30 @@ protected:
 
 	EFlowFinishPolicy FinishPolicy;
 
+private:
+	// Owner context resolved once per instance, so nodes don't cast the owner and walk outers on every execution
+	// Resolved while initializing the instance and starting the flow, invalidated on world cleanup
+	TWeakObjectPtr<AActor> CachedActorOwner;
+	TWeakInterfacePtr<IFlowOwnerInterface> CachedFlowOwnerInterface;
+	TWeakObjectPtr<UWorld> CachedWorld;
+	bool bOwnerContextCached;
+
 public:
 	virtual void InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlowAsset* InTemplateAsset);
 	virtual void DeinitializeInstance();
 
+protected:
+	// Pooled instance keeps its node instances, these are initialized again for the new owner
+	virtual void InitializePooledInstance(const TWeakObjectPtr<UObject> InOwner);
+
+	// Called on deinitialized instance before returning it to the pool
+	// SaveGame properties of the asset and nodes are copied from templates, so the state of the previous use never gets saved
+	virtual void ResetPooledInstance();
+
+	static void CopySaveGameProperties(UObject* Instance, const UObject* Template);
+
+public:
+
 	UFlowAsset* GetTemplateAsset() const { return TemplateAsset; }
 
 	// Object that spawned Root Flow instance, i.e. World Settings or Player Controller
@@ -329,6 +475,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Flow")
 	AActor* TryFindActorOwner() const;
 
+	// Caching is skipped for template assets, as these never have an owner
+	void CacheOwnerContext();
+	void InvalidateOwnerContext();
+	bool IsOwnerContextCached() const { return bOwnerContextCached; }
+
 	// Opportunity to preload content of project-specific nodes
 	virtual void PreloadNodes() {}
 
@@ -347,7 +498,23 @@ protected:
 	void TriggerCustomInput_FromSubGraph(UFlowNode_SubGraph* Node, const FName& EventName) const;
 	void TriggerCustomOutput(const FName& EventName);
 
+	// Equivalents of starting and finishing Sub Graph instance, if Sub Graph was inlined while cooking
+	void TriggerInlinedSubGraph(UFlowNode_SubGraph* SubGraphNode, const FName& PinName);
+	void TriggerInlinedCustomOutput(const UFlowNode_CustomOutput* Node, const FName& EventName) const;
+	void FinishInlinedSubGraph(const UFlowNode_SubGraph* SubGraphNode);
+	void GetInlinedNodes(const UFlowNode_SubGraph* SubGraphNode, TArray<UFlowNode*>& OutNodes) const;
+
 	void TriggerInput(const FGuid& NodeGuid, const FName& PinName);
+	void TriggerInput(const int32 CompiledNodeIndex, const FName& PinName);
+	void TriggerNodeInput(UFlowNode* Node, const FName& PinName);
+	void TriggerCompiledOutput(const int32 CompiledNodeIndex, const FName& PinName, const TSet<FGuid>* ExcludedNodes = nullptr);
+
+	bool CanExecuteLightweight(const UFlowNode& Node) const;
+	void InitializeLightweightNodeStates();
+	void InitializeLightweightNodeState(const FLightweightNode& LightweightNode);
+
+	// Equivalent of GetNodesInExecutionOrder which follows compiled connections, including lightweight nodes
+	void GetCompiledNodesInExecutionOrder(const int32 FirstNodeIndex, TArray<UFlowNode*>& OutNodes) const;
 
 	void FinishNode(UFlowNode* Node);
 	void ResetNodes();
@@ -394,6 +561,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
 	void LoadInstance(const FFlowAssetSaveData& AssetRecord);
 
+	// Returns true if all active nodes can hibernate, see UFlowNode::CanHibernate
+	virtual bool CanHibernate(FFlowWakeUpConditions& OutConditions) const;
+
 protected:
 	virtual void OnActivationStateLoaded(UFlowNode* Node);
 
@@ -0,0 +1,154 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "FlowCompiledGraph.generated.h"
+
+// Connection from the output pin of compiled node to the input pin of another compiled node
+USTRUCT()
+struct FLOW_API FFlowCompiledEdge
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FName OutputPinName;
+
+	// Index of the connected node in FFlowCompiledGraph::Nodes
+	UPROPERTY()
+	int32 TargetNode;
+
+	UPROPERTY()
+	FName TargetPinName;
+
+	// Final target after skipping chain of pure pass-through nodes, INDEX_NONE if chain ends with unconnected pin
+	UPROPERTY()
+	int32 CollapsedTargetNode;
+
+	UPROPERTY()
+	FName CollapsedTargetPinName;
+
+	FFlowCompiledEdge()
+		: OutputPinName(NAME_None)
+		, TargetNode(INDEX_NONE)
+		, TargetPinName(NAME_None)
+		, CollapsedTargetNode(INDEX_NONE)
+		, CollapsedTargetPinName(NAME_None)
+	{
+	}
+
+	FFlowCompiledEdge(const FName& InOutputPinName, const int32 InTargetNode, const FName& InTargetPinName)
+		: OutputPinName(InOutputPinName)
+		, TargetNode(InTargetNode)
+		, TargetPinName(InTargetPinName)
+		, CollapsedTargetNode(InTargetNode)
+		, CollapsedTargetPinName(InTargetPinName)
+	{
+	}
+};
+
+USTRUCT()
+struct FLOW_API FFlowCompiledNode
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FGuid NodeGuid;
+
+	// Outgoing edges of the node are stored contiguously in FFlowCompiledGraph::Edges
+	UPROPERTY()
+	int32 FirstEdge;
+
+	UPROPERTY()
+	int32 NumEdges;
+
+	// Pure pass-through node that edges can skip, see UFlowNode::IsPurePassThrough
+	UPROPERTY()
+	bool bCollapsible;
+
+	FFlowCompiledNode()
+		: FirstEdge(0)
+		, NumEdges(0)
+		, bCollapsible(false)
+	{
+	}
+
+	explicit FFlowCompiledNode(const FGuid& InNodeGuid)
+		: NodeGuid(InNodeGuid)
+		, FirstEdge(0)
+		, NumEdges(0)
+		, bCollapsible(false)
+	{
+	}
+};
+
+/**
+ * Runtime representation of the Flow Asset connections, compiled while saving the asset
+ * Signals are dispatched by node index, without searching node map or connection maps of nodes
+ * Graph is immutable at runtime and shared by all instances of the template asset
+ */
+USTRUCT()
+struct FLOW_API FFlowCompiledGraph
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<FFlowCompiledNode> Nodes;
+
+	UPROPERTY()
+	TArray<FFlowCompiledEdge> Edges;
+
+	// Set after compiling, even if the graph is empty
+	// Graphs compiled by the older version are compiled again on the first use
+	UPROPERTY()
+	int32 Version = 0;
+
+	// 2: outputs connected to multiple inputs
+	static constexpr int32 LatestVersion = 2;
+
+	bool IsCompiled() const { return Version == LatestVersion; }
+
+	void Reset()
+	{
+		Nodes.Empty();
+		Edges.Empty();
+		Version = 0;
+	}
+
+	// Nodes usually have a few outputs, so comparing names is cheaper than any lookup structure
+	const FFlowCompiledEdge* FindEdge(const int32 NodeIndex, const FName& OutputPinName) const
+	{
+		if (Nodes.IsValidIndex(NodeIndex))
+		{
+			const FFlowCompiledNode& Node = Nodes[NodeIndex];
+			for (int32 EdgeIndex = Node.FirstEdge; EdgeIndex < Node.FirstEdge + Node.NumEdges; EdgeIndex++)
+			{
+				if (Edges[EdgeIndex].OutputPinName == OutputPinName)
+				{
+					return &Edges[EdgeIndex];
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Output connected to multiple inputs has consecutive edges, in order of passing the signal
+	TArrayView<const FFlowCompiledEdge> FindEdges(const int32 NodeIndex, const FName& OutputPinName) const
+	{
+		if (const FFlowCompiledEdge* FirstEdge = FindEdge(NodeIndex, OutputPinName))
+		{
+			const int32 FirstIndex = static_cast<int32>(FirstEdge - Edges.GetData());
+			const int32 EndIndex = Nodes[NodeIndex].FirstEdge + Nodes[NodeIndex].NumEdges;
+
+			int32 NumEdges = 1;
+			while (FirstIndex + NumEdges < EndIndex && Edges[FirstIndex + NumEdges].OutputPinName == OutputPinName)
+			{
+				NumEdges++;
+			}
+
+			return MakeArrayView(FirstEdge, NumEdges);
+		}
+
+		return TArrayView<const FFlowCompiledEdge>();
+	}
+};
@@ -130,6 +130,8 @@ private:
 	UFUNCTION()
 	void OnRep_SentNotifyTags();
 
+	void BroadcastNotify(const FGameplayTag& NotifyTag);
+
 public:
 	FFlowComponentNotify OnNotifyFromComponent;
 
@@ -198,6 +200,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "RootFlow")
 	void StartRootFlow();
 
+	// Starts Root Flows of many components at once, i.e. after spawning a wave of actors with disabled Auto Start Root Flow
+	// Cheaper than calling StartRootFlow on every component, see UFlowSubsystem::StartRootFlows
+	UFUNCTION(BlueprintCallable, Category = "RootFlow")
+	static void StartRootFlows(const TArray<UFlowComponent*>& Components);
+
 	// This will destroy instantiated Flow Asset - created from asset assigned on this component.
 	UFUNCTION(BlueprintCallable, Category = "RootFlow")
 	void FinishRootFlow(UFlowAsset* TemplateAsset, const EFlowFinishPolicy FinishPolicy);
@@ -208,6 +215,26 @@ public:
 	UFUNCTION(BlueprintPure, Category = "RootFlow", meta = (DeprecatedFunction, DeprecationMessage="Use GetRootInstances() instead."))
 	UFlowAsset* GetRootFlowInstance() const;
 
+//////////////////////////////////////////////////////////////////////////
+// Significance
+
+private:
+	UPROPERTY(Transient)
+	float Significance;
+
+public:
+	// Flow Graphs owned by this component are throttled while its significance is below UFlowSettings::ThrottledSignificance
+	// Throttled graphs execute timers in batches and receive notifies from this component in the next frame
+	// Deferred work is executed in the original order, immediately after the component becomes significant again
+	// Intended to be driven by the project's significance logic, i.e. USignificanceManager
+	UFUNCTION(BlueprintCallable, Category = "Flow")
+	void SetSignificance(const float NewSignificance);
+
+	UFUNCTION(BlueprintPure, Category = "Flow")
+	float GetSignificance() const { return Significance; }
+
+	bool IsThrottled() const;
+
 //////////////////////////////////////////////////////////////////////////
 // UFlowComponent overrideable events
 
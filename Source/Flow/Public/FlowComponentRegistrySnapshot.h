@@ -0,0 +1,52 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UFlowComponent;
+
+/**
+ * Immutable copy of the Flow Component registry, published by the Flow Subsystem at most once per frame
+ * - can be queried from any thread without locking, i.e. by AI or perception tasks running on worker threads
+ * - acquiring it is lock-free, UFlowSubsystem::GetRegistrySnapshot never waits for the publishing game thread
+ * - weak pointers can be resolved only on the game thread, or while garbage collection can't run (see FGCScopeGuard)
+ */
+struct FLOW_API FFlowComponentRegistrySnapshot : public TSharedFromThis<FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe>
+{
+	FFlowComponentRegistrySnapshot();
+
+	/* Has to be created on the game thread, as it resolves owners of registered components */
+	FFlowComponentRegistrySnapshot(const TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>>& Registry, const uint64 InFrameNumber);
+
+	/* See UFlowSubsystem::GetFlowComponentsByTag */
+	void FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+	void FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+
+	/* See UFlowSubsystem::GetFlowActorsByTag */
+	void FindActors(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<AActor>>& OutActors) const;
+	void FindActors(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<AActor>>& OutActors) const;
+
+	/* Value of GFrameCounter when the snapshot was created */
+	uint64 GetFrameNumber() const { return FrameNumber; }
+
+	int32 NumTags() const { return EntriesByTag.Num(); }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UFlowComponent> Component;
+		TWeakObjectPtr<AActor> Actor;
+	};
+
+	TMap<FGameplayTag, TArray<FEntry>> EntriesByTag;
+	uint64 FrameNumber;
+
+	void FindEntries(const FGameplayTag& Tag, const bool bExactMatch, TArray<const FEntry*>& OutEntries) const;
+	void FindEntries(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TArray<const FEntry*>& OutEntries) const;
+};
+
+typedef TSharedRef<const FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe> FFlowComponentRegistrySnapshotRef;
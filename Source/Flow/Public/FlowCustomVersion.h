@@ -0,0 +1,28 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Misc/Guid.h"
+
+// Custom serialization version of the Flow plugin assets
+struct FLOW_API FFlowCustomVersion
+{
+	enum Type
+	{
+		// Before any version changes were made in the plugin
+		BeforeCustomVersionWasAdded = 0,
+
+		// Compiled graph is serialized by the Flow Asset, instead of being a property copied to every instance
+		CompiledGraphSerializedByAsset,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// The GUID for this custom version number
+	const static FGuid GUID;
+
+private:
+	FFlowCustomVersion() {}
+};
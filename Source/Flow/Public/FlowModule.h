@@ -9,4 +9,11 @@ class FFlowModule final : public IModuleInterface
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	// Blueprint recompile and hot reload replace classes cached by the runtime
+	static void ResetClassCaches();
+
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle ReloadCompleteHandle;
 };
@@ -0,0 +1,79 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/Queue.h"
+#include "GameplayTagContainer.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <atomic>
+
+#include "FlowTypes.h"
+
+class UFlowAsset;
+class UFlowComponent;
+
+/**
+ * Notifies queued by any thread, sent by the owning Flow Subsystem at the start of its next tick
+ * - worker threads keep the queue by UFlowSubsystem::GetNotifyQueue, instead of the subsystem pointer
+ * - queue outlives the subsystem, notifies queued after the subsystem deinitialized are dropped
+ */
+class FLOW_API FFlowNotifyQueue
+{
+	friend class UFlowSubsystem;
+
+public:
+	FFlowNotifyQueue();
+
+	/* Alternatives to UFlowComponent::NotifyGraph, UFlowComponent::NotifyActor and UFlowAsset::TriggerCustomInput, callable from any thread
+	 * Notifies are sent in the order of queueing by each thread, repeated notify is sent once if the same thread queued it right before */
+	void QueueNotifyGraph(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+	void QueueNotifyActor(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+	void QueueCustomInput(const TWeakObjectPtr<UFlowAsset>& FlowInstance, const FName& EventName);
+
+	/* True after the owning subsystem deinitialized */
+	bool IsClosed() const { return bClosed.load(); }
+
+private:
+	struct FQueuedNotify
+	{
+		enum class EType : uint8
+		{
+			Graph,
+			Actor,
+			CustomInput
+		};
+
+		EType Type = EType::Graph;
+		EFlowNetMode NetMode = EFlowNetMode::Authority;
+
+		/* Thread queueing the notify, repeated notifies are collapsed only within the same thread */
+		uint32 ProducerId = 0;
+
+		/* Flow Component or Flow Asset instance */
+		TWeakObjectPtr<UObject> Target;
+
+		FGameplayTag ActorTag;
+		FGameplayTag NotifyTag;
+		FName EventName;
+
+		bool operator==(const FQueuedNotify& Other) const
+		{
+			return Type == Other.Type && NetMode == Other.NetMode && Target == Other.Target
+				&& ActorTag == Other.ActorTag && NotifyTag == Other.NotifyTag && EventName == Other.EventName;
+		}
+	};
+
+	/* Lock-free queue written by any thread, read only by the game thread */
+	TQueue<FQueuedNotify, EQueueMode::Mpsc> Notifies;
+	std::atomic<bool> bClosed;
+
+	void Enqueue(FQueuedNotify&& Notify);
+
+	/* Called on the game thread by the owning subsystem */
+	bool Dequeue(FQueuedNotify& OutNotify);
+	bool IsEmpty() const { return Notifies.IsEmpty(); }
+	void Close();
+};
+
+typedef TSharedRef<FFlowNotifyQueue, ESPMode::ThreadSafe> FFlowNotifyQueueRef;
@@ -3,12 +3,74 @@
 #pragma once
 
 #include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
 
 #include "FlowOwnerFunctionRef.generated.h"
 
 class UFlowOwnerFunctionParams;
 class IFlowOwnerInterface;
 
+// Native owner function called directly, without going through ProcessEvent
+typedef FName (*FFlowOwnerNativeFunction)(UObject& Owner, UFlowOwnerFunctionParams& Params);
+
+// Opt-in native bindings for owner functions implemented in C++
+//  bindings are used only if the function resolved on the owner class is native, so Blueprint overrides still go through reflection
+//  register function implementation, i.e. MyFunction_Implementation in case of BlueprintNativeEvent
+class FLOW_API FFlowOwnerNativeFunctionRegistry
+{
+public:
+	static void Register(const UClass* OwnerClass, const FName& FunctionName, FFlowOwnerNativeFunction NativeFunction);
+	static void Unregister(const UClass* OwnerClass, const FName& FunctionName);
+
+	// Finds binding registered for given class or its closest parent class
+	static FFlowOwnerNativeFunction Find(const UClass& OwnerClass, const FName& FunctionName);
+
+	template <typename OwnerT, typename ParamsT, FName (OwnerT::*Function)(ParamsT*)>
+	static FName Invoke(UObject& Owner, UFlowOwnerFunctionParams& Params)
+	{
+		return (CastChecked<OwnerT>(&Owner)->*Function)(CastChecked<ParamsT>(&Params));
+	}
+
+private:
+	static TMap<TPair<TObjectKey<UClass>, FName>, FFlowOwnerNativeFunction> NativeFunctions;
+};
+
+// Binds UFunction named FunctionName to the C++ member function NativeFunction, i.e. called from module startup:
+//  FLOW_REGISTER_OWNER_FUNCTION(AMyCharacter, SelectDialogueLine, SelectDialogueLine_Implementation, UMyDialogueParams);
+#define FLOW_REGISTER_OWNER_FUNCTION(OwnerClass, FunctionName, NativeFunction, ParamsClass) \
+	FFlowOwnerNativeFunctionRegistry::Register(OwnerClass::StaticClass(), GET_FUNCTION_NAME_CHECKED(OwnerClass, FunctionName), \
+		&FFlowOwnerNativeFunctionRegistry::Invoke<OwnerClass, ParamsClass, &OwnerClass::NativeFunction>)
+
+// Owner functions resolved for (owner class, function name, params class)
+//  shared by all CallOwnerFunction nodes, flushed when classes are recompiled or reloaded
+class FLOW_API FFlowOwnerFunctionCache
+{
+public:
+	struct FEntry
+	{
+		TWeakObjectPtr<UFunction> Function;
+
+		// Function takes a single params object compatible with the params class and returns FName
+		bool bValidSignature = false;
+
+		// Missing functions are cached too
+		bool bResolved = false;
+
+		// Set if function is native and its owner class registered the native binding
+		FFlowOwnerNativeFunction NativeFunction = nullptr;
+	};
+
+	static const FEntry& FindOrResolve(const UClass& OwnerClass, const FName& FunctionName, const UClass& ParamsClass);
+
+	static void Reset();
+
+	static bool IsSignatureCompatible(const UFunction& Function, const UClass& ParamsClass);
+
+private:
+	typedef TTuple<TObjectKey<UClass>, FName, TObjectKey<UClass>> FKey;
+	static TMap<FKey, FEntry> Entries;
+};
+
 // Similar to FAnimNodeFunctionRef, providing a FName-based function binding
 //  that is resolved at runtime
 USTRUCT(BlueprintType)
@@ -20,11 +82,19 @@ struct FFlowOwnerFunctionRef
 	friend class UFlowNode_CallOwnerFunction;
 	friend class FFlowOwnerFunctionRefCustomization;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FFlowOwnerFunctionCallBenchmark;
+#endif
+
 public:
 
 	// Resolves the function and returns the UFunction
 	UFunction* TryResolveFunction(const UClass& InClass);
 
+	// Resolves the function through FFlowOwnerFunctionCache
+	//  returns null if the function doesn't accept given params class
+	UFunction* TryResolveFunction(const UClass& InClass, const UClass& InParamsClass);
+
 	// Returns a the resolved function
 	//  (assumes TryResolveFunction was called previously)
 	UFunction* GetResolvedFunction() const { return Function; }
@@ -32,6 +102,9 @@ public:
 	// Call the function and return the Output Pin Name result
 	FName CallFunction(IFlowOwnerInterface& InFlowOwnerInterface, UFlowOwnerFunctionParams& InParams) const;
 
+	// Call the function and return the Output Pin Name result, validated against already gathered output names
+	FName CallFunction(IFlowOwnerInterface& InFlowOwnerInterface, UFlowOwnerFunctionParams& InParams, const TArray<FName>& InOutputNames) const;
+
 	// Accessors
 	FName GetFunctionName() const { return FunctionName; }
 	bool IsConfigured() const { return !FunctionName.IsNone(); }
@@ -48,6 +121,10 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UFunction> Function = nullptr;
 
+	// Native binding of the function, called instead of ProcessEvent
+	//  (resolved only through the FFlowOwnerFunctionCache)
+	FFlowOwnerNativeFunction NativeFunction = nullptr;
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(VisibleAnywhere, Category = "FlowOwnerFunction", meta = (DisplayName = "Function Parameters Class"))
 	TSubclassOf<UFlowOwnerFunctionParams> ParamsClass;
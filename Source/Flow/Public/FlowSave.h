@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFramework/SaveGame.h"
+#include "GameplayTagContainer.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "FlowSave.generated.h"
 
@@ -19,6 +20,8 @@ struct FLOW_API FFlowNodeSaveData
 
 	friend FArchive& operator<<(FArchive& Ar, FFlowNodeSaveData& InNodeData)
 	{
+		Ar << InNodeData.NodeGuid;
+		Ar << InNodeData.NodeData;
 		return Ar;
 	}
 };
@@ -42,6 +45,10 @@ struct FLOW_API FFlowAssetSaveData
 
 	friend FArchive& operator<<(FArchive& Ar, FFlowAssetSaveData& InAssetData)
 	{
+		Ar << InAssetData.WorldName;
+		Ar << InAssetData.InstanceName;
+		Ar << InAssetData.AssetData;
+		Ar << InAssetData.NodeRecords;
 		return Ar;
 	}
 };
@@ -62,10 +69,73 @@ struct FLOW_API FFlowComponentSaveData
 
 	friend FArchive& operator<<(FArchive& Ar, FFlowComponentSaveData& InComponentData)
 	{
+		Ar << InComponentData.WorldName;
+		Ar << InComponentData.ActorInstanceName;
+		Ar << InComponentData.ComponentData;
 		return Ar;
 	}
 };
 
+/**
+ * Events waking up the hibernated Flow Asset instance, collected from its active nodes
+ * Conditions are conservative, instance might wake up and only go back to waiting
+ */
+USTRUCT()
+struct FLOW_API FFlowWakeUpConditions
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Wakes up after registering Flow Component with any of these tags or their child tags, also after adding such tag to the component */
+	UPROPERTY()
+	FGameplayTagContainer IdentityTags;
+
+	/* Wakes up if Flow Component matching Identity Tags notifies graph with one of these tags */
+	UPROPERTY()
+	FGameplayTagContainer NotifyTags;
+
+	UPROPERTY()
+	bool bAnyNotifyTag = false;
+
+	/* Wakes up after this time passes in the time of the Root Flow owner, negative if not used */
+	UPROPERTY()
+	float Delay = -1.0f;
+
+	void AddDelay(const float InDelay)
+	{
+		Delay = Delay < 0.0f ? InDelay : FMath::Min(Delay, InDelay);
+	}
+
+	bool IsValid() const { return IdentityTags.IsValid() || Delay >= 0.0f; }
+};
+
+/**
+ * Records of a single world, compressed in chunks
+ * Block is decompressed only if records of its world are requested, otherwise it's carried forward untouched on save
+ */
+USTRUCT()
+struct FLOW_API FFlowWorldSaveBlock
+{
+	GENERATED_USTRUCT_BODY()
+
+	static constexpr int32 ChunkSize = 256 * 1024;
+
+	UPROPERTY(VisibleAnywhere, Category = "Flow")
+	FString WorldName;
+
+	UPROPERTY()
+	FName CompressionFormat;
+
+	UPROPERTY()
+	int32 UncompressedSize = 0;
+
+	/* Every chunk except the last one contains ChunkSize bytes before compression */
+	UPROPERTY()
+	TArray<int32> CompressedChunkSizes;
+
+	UPROPERTY()
+	TArray<uint8> CompressedData;
+};
+
 struct FLOW_API FFlowArchive : public FObjectAndNameAsStringProxyArchive
 {
 	FFlowArchive(FArchive& InInnerArchive) : FObjectAndNameAsStringProxyArchive(InInnerArchive, true)
@@ -74,6 +144,33 @@ struct FLOW_API FFlowArchive : public FObjectAndNameAsStringProxyArchive
 	}
 };
 
+/**
+ * Records of the SaveGame detached from the SaveGame object
+ * Background save task compresses records moved out of the SaveGame, so it never touches UObjects
+ */
+struct FLOW_API FFlowSaveGameRecords
+{
+	TArray<FFlowComponentSaveData> FlowComponents;
+	TArray<FFlowAssetSaveData> FlowInstances;
+	TArray<FFlowWorldSaveBlock> WorldBlocks;
+
+	/* Moves all uncompressed records to per-world compressed blocks, safe to call from any thread */
+	void PackWorldBlocks(const FName CompressionFormat);
+
+	/* Moves records of given world from its compressed block to FlowComponents and FlowInstances */
+	bool UnpackWorldBlock(const FString& WorldName);
+};
+
+/**
+ * Transient lookup of records bound to a single world
+ * Values are indexes into UFlowSaveGame::FlowComponents and UFlowSaveGame::FlowInstances
+ */
+struct FLOW_API FFlowWorldSaveIndex
+{
+	TMap<FString, int32> ComponentsByActorName;
+	TMap<FString, int32> InstancesByName;
+};
+
 UCLASS(BlueprintType)
 class FLOW_API UFlowSaveGame : public USaveGame
 {
@@ -90,11 +187,45 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = "Flow")
 	TArray<FFlowAssetSaveData> FlowInstances;
-	
+
+	/* Table of contents: compressed records of worlds that haven't been requested since loading the SaveGame */
+	UPROPERTY(VisibleAnywhere, Category = "Flow")
+	TArray<FFlowWorldSaveBlock> WorldBlocks;
+
 	friend FArchive& operator<<(FArchive& Ar, UFlowSaveGame& SaveGame)
 	{
 		Ar << SaveGame.FlowComponents;
 		Ar << SaveGame.FlowInstances;
 		return Ar;
 	}
+
+private:
+	/* Records partitioned by world name, records not bound to any world are stored under the empty name */
+	mutable TMap<FString, FFlowWorldSaveIndex> WorldIndexes;
+	mutable bool bWorldIndexesValid = false;
+
+public:
+	/* Rebuilds lookup of records, called after loading SaveGame */
+	void BuildWorldIndexes() const;
+	void InvalidateWorldIndexes() { bWorldIndexesValid = false; }
+
+	/* Decompresses block of given world and block of records not bound to any world, if needed */
+	const FFlowComponentSaveData* FindComponentRecord(const FString& WorldName, const FString& ActorInstanceName);
+	const FFlowAssetSaveData* FindInstanceRecord(const FString& WorldName, const FString& InstanceName);
+
+	/* Removes records bound to given world and records not bound to any world */
+	void RemoveWorldRecords(const FString& WorldName);
+
+	/* Moves all uncompressed records to per-world compressed blocks
+	 * Background tasks should pack records detached by SwapRecords instead */
+	void PackWorldBlocks(const FName CompressionFormat);
+
+	/* Moves records of given world and records not bound to any world from compressed blocks to FlowComponents and FlowInstances */
+	void UnpackWorldBlocks(const FString& WorldName);
+
+	/* Exchanges records of this SaveGame with given ones, i.e. to serialize SaveGame with packed records and restore it afterwards */
+	void SwapRecords(FFlowSaveGameRecords& Records);
+
+private:
+	bool UnpackWorldBlock(const FString& WorldName);
 };
@@ -27,6 +27,60 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
 	bool bWarnAboutMissingIdentityTags;
 
+	// If enabled, SaveGames written by UFlowSubsystem::SaveGameToSlotAsync store Flow records in compressed per-world blocks
+	// After loading the game, only blocks of the current world are decompressed
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
+	bool bCompressSaveGame;
+
+	// Format passed to FCompression, i.e. Zlib, Gzip, LZ4, Oodle
+	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem", meta = (EditCondition = "bCompressSaveGame"))
+	FName SaveGameCompressionFormat;
+
+	// If enabled, simple route nodes like Reroute, OR, AND, Counter or Multi Gate (up to 32 outputs) aren't instanced outside of the editor
+	// Such nodes execute on the template node and their state is stored by the Flow Asset instance
+	// Changing this setting invalidates states of these nodes in existing SaveGames
+	UPROPERTY(Config, EditAnywhere, Category = "Flow")
+	bool bLightweightRouteNodes;
+
+	// If enabled, route nodes are executed without node instances also while playing in the editor, so PIE behaves like the cooked game
+	// Disabled by default, as the debugger can't display state of nodes without instances
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (EditCondition = "bLightweightRouteNodes"))
+	bool bLightweightRouteNodesInEditor;
+
+	// If enabled, nodes not reachable from any entry node (Start, Custom Input, etc.) are removed while cooking Flow Asset
+	// Disabled by default, as project code might find nodes by GUID or class, regardless of their connections
+	UPROPERTY(Config, EditAnywhere, Category = "Flow")
+	bool bStripUnreachableNodesOnCook;
+
+	// If enabled, signals skip pure pass-through nodes like Reroute, these nodes aren't instanced outside of the editor
+	UPROPERTY(Config, EditAnywhere, Category = "Flow")
+	bool bCollapsePassThroughNodes;
+
+	// If enabled, pass-through nodes are collapsed also while playing in the editor, so PIE behaves like the cooked game
+	// Disabled by default, as the debugger can't display signals passing through collapsed nodes
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (EditCondition = "bCollapsePassThroughNodes"))
+	bool bCollapsePassThroughNodesInEditor;
+
+	// Sub Graph assets with up to this number of nodes are copied into the parent asset while cooking, 0 disables it
+	// Inlined Sub Graph doesn't create Flow Asset instance, its nodes are executed by the parent instance
+	// Sub Graphs containing other Sub Graph nodes are never inlined
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (ClampMin = 0))
+	int32 MaxInlinedSubGraphNodes;
+
+	// Flow Components with significance below this value throttle their Flow Graphs, 0 disables throttling
+	// See UFlowComponent::SetSignificance
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (ClampMin = 0))
+	float ThrottledSignificance;
+
+	// Timers of throttled Flow Graphs are executed in batches, once per this interval
+	UPROPERTY(Config, EditAnywhere, Category = "Flow", meta = (ClampMin = 0))
+	float ThrottledTimersInterval;
+
+	// If disabled, Flow Graphs of the ending world are dropped without calling Cleanup on their active nodes
+	// Speeds up level transitions, but it's only safe if nodes don't need to unbind from objects outliving the world
+	UPROPERTY(Config, EditAnywhere, Category = "Flow")
+	bool bCleanupNodesOnWorldTeardown;
+
 	// If enabled, runtime logs will be added when a flow node signal mode is set to Disabled
 	UPROPERTY(Config, EditAnywhere, Category = "Flow")
 	bool bLogOnSignalDisabled;
@@ -45,6 +99,9 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	FSoftClassPath DefaultExpectedOwnerClass;
 
 public:
+	bool ShouldCollapsePassThroughNodes() const { return bCollapsePassThroughNodes && (!GIsEditor || bCollapsePassThroughNodesInEditor); }
+	bool ShouldExecuteLightweightRouteNodes() const { return bLightweightRouteNodes && (!GIsEditor || bLightweightRouteNodesInEditor); }
+
 	UClass* GetDefaultExpectedOwnerClass() const;
 
 	static UClass* TryResolveOrLoadSoftClass(const FSoftClassPath& SoftClassPath);
@@ -5,27 +5,105 @@
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "Tickable.h"
+#include <atomic>
 
 #include "FlowComponent.h"
+#include "FlowComponentRegistrySnapshot.h"
+#include "FlowNotifyQueue.h"
+#include "FlowSave.h"
+#include "FlowTimerWheel.h"
 #include "FlowSubsystem.generated.h"
 
 class UFlowAsset;
 class UFlowNode_SubGraph;
 
+/* Finished Sub Graph instance kept for reuse */
+USTRUCT()
+struct FFlowPooledInstance
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UFlowAsset* Instance = nullptr;
+
+	/* World of the instance owner, instance is dropped from the pool while tearing down this world */
+	TWeakObjectPtr<UWorld> World;
+};
+
+/* Finished Sub Graph instances of the single template asset, kept for reuse */
+USTRUCT()
+struct FFlowInstancePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlowPooledInstance> Instances;
+};
+
+/* Single Root Flow started by UFlowSubsystem::StartRootFlows */
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowRootFlowRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	UObject* Owner = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	UFlowAsset* FlowAsset = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow")
+	bool bAllowMultipleInstances = true;
+
+	FFlowRootFlowRequest() {}
+
+	FFlowRootFlowRequest(UObject* InOwner, UFlowAsset* InFlowAsset, const bool bInAllowMultipleInstances = true)
+		: Owner(InOwner)
+		, FlowAsset(InFlowAsset)
+		, bAllowMultipleInstances(bInAllowMultipleInstances)
+	{
+	}
+};
+
+/* Root Flow instance destroyed while waiting for an event, restored from its SaveGame record once the event occurs */
+USTRUCT()
+struct FFlowHibernatedInstance
+{
+	GENERATED_BODY()
+
+	/* Keeps template loaded, even if it has no active instances */
+	UPROPERTY()
+	UFlowAsset* TemplateAsset = nullptr;
+
+	TWeakObjectPtr<UObject> Owner;
+
+	UPROPERTY()
+	FFlowAssetSaveData Record;
+
+	UPROPERTY()
+	FFlowWakeUpConditions WakeUpConditions;
+
+	FFlowTimerHandle WakeUpTimerHandle;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSimpleFlowEvent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSimpleFlowComponentEvent, UFlowComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTaggedFlowComponentEvent, UFlowComponent*, Component, const FGameplayTagContainer&, Tags);
 
 DECLARE_DELEGATE_OneParam(FNativeFlowAssetEvent, class UFlowAsset*);
+DECLARE_DELEGATE_TwoParams(FFlowSaveGameCompleted, class UFlowSaveGame* /*SaveGame*/, const bool /*bSuccess*/);
 
 /**
  * Flow Subsystem
  * - manages lifetime of Flow Graphs
  * - connects Flow Graphs with actors containing the Flow Component
+ * - runs timers of Flow Nodes
  * - convenient base for project-specific systems
  */
 UCLASS()
-class FLOW_API UFlowSubsystem : public UGameInstanceSubsystem
+class FLOW_API UFlowSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
@@ -36,6 +114,11 @@ public:
 	friend class UFlowComponent;
 	friend class UFlowNode_SubGraph;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FFlowComponentRegistrySnapshotTest;
+	friend class FFlowTestFixture;
+#endif
+
 private:
 	/* All asset templates with active instances */
 	UPROPERTY()
@@ -49,6 +132,10 @@ private:
 	UPROPERTY()
 	TMap<UFlowNode_SubGraph*, UFlowAsset*> InstancedSubFlows;
 
+	/* Deinitialized Sub Graph instances waiting for reuse, see UFlowAsset::MaxPooledInstances */
+	UPROPERTY()
+	TMap<UFlowAsset*, FFlowInstancePool> PooledSubFlows;
+
 #if WITH_EDITOR
 public:
 	/* Called after creating the first instance of given Flow Asset */
@@ -77,6 +164,12 @@ public:
 
 	virtual UFlowAsset* CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true);
 
+	/* Starts many Root Flows at once, i.e. for a wave of spawned actors
+	 * Every template is prepared once and all instances are created before starting the first one
+	 * OutInstances matches Requests by index, it contains nullptr for requests that failed */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void StartRootFlows(const TArray<FFlowRootFlowRequest>& Requests, TArray<UFlowAsset*>& OutInstances);
+
 	/* Finish Policy value is read by Flow Node
 	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
 	 * Example: Spawn node might despawn all actors if Flow Graph is aborted, not completed */
@@ -95,6 +188,19 @@ protected:
 
 	UFlowAsset* CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName = FString());
 
+	/* Called before creating instances of the loaded template */
+	void PrepareTemplate(UFlowAsset* Template);
+	UFlowAsset* InstantiateTemplate(const TWeakObjectPtr<UObject> Owner, UFlowAsset* Template, const FName InstanceName);
+
+	/* Fills the pool of Sub Graph asset with new instances, up to UFlowAsset::MaxPooledInstances */
+	void WarmSubFlowPool(UFlowNode_SubGraph* SubGraphNode);
+
+	/* Returns null if there's no pooled instance of given asset */
+	UFlowAsset* AcquirePooledSubFlow(const TWeakObjectPtr<UObject> Owner, const TSoftObjectPtr<UFlowAsset>& FlowAsset);
+
+	/* Finishes instance and keeps it for reuse, returns false if the pool of template asset is full */
+	bool ReleaseSubFlowToPool(UFlowAsset* AssetInstance, const EFlowFinishPolicy FinishPolicy);
+
 	virtual void AddInstancedTemplate(UFlowAsset* Template);
 	virtual void RemoveInstancedTemplate(UFlowAsset* Template);
 
@@ -116,9 +222,156 @@ public:
 
 	virtual UWorld* GetWorld() const override;
 
+protected:
+	/* Flow Asset instances cache the world, it needs to be resolved again after world cleanup */
+	virtual void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	FDelegateHandle WorldCleanupHandle;
+
+//////////////////////////////////////////////////////////////////////////
+// Teardown
+
+private:
+	/* Instances finished in bulk don't remove themselves from templates, see FinishInstancesInBulk */
+	bool bBulkTeardown = false;
+
+	TWeakObjectPtr<UWorld> TornDownWorld;
+
+public:
+	bool IsBulkTeardown() const { return bBulkTeardown; }
+
+	/* True if flows of the given world have been already torn down, Flow Components don't need to unregister one by one */
+	bool IsWorldTornDown(const UWorld* World) const { return World && TornDownWorld.Get() == World; }
+
+	/* Finishes all flows owned by objects of the ending world at once, called by the first Flow Component ending play with the world
+	 * Unlike finishing flows one by one, it doesn't broadcast OnComponentUnregistered and doesn't update registries per instance
+	 * Cleanup of active nodes is optional, see UFlowSettings::bCleanupNodesOnWorldTeardown */
+	virtual void TeardownWorldFlows(UWorld* World);
+
+protected:
+	/* Removes instances from templates and subsystem maps in a single pass for each container */
+	void FinishInstancesInBulk(const TSet<UFlowAsset*>& Instances, const bool bCleanupNodes);
+
+//////////////////////////////////////////////////////////////////////////
+// Tick
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetGameInstance() ? GetWorld() : nullptr; }
+	virtual TStatId GetStatId() const override;
+
+//////////////////////////////////////////////////////////////////////////
+// Timers
+
+protected:
+	/* Timers of all Flow Nodes, advanced by the world's delta time */
+	FFlowTimerWheel TimerWheel;
+
+public:
+	FFlowTimerWheel& GetTimerWheel() { return TimerWheel; }
+	const FFlowTimerWheel& GetTimerWheel() const { return TimerWheel; }
+
+//////////////////////////////////////////////////////////////////////////
+// Hibernation
+
+private:
+	/* Root Flows waiting for an event without instances, keyed by the name of destroyed instance */
+	UPROPERTY()
+	TMap<FName, FFlowHibernatedInstance> HibernatedFlows;
+
+	/* Lookup of HibernatedFlows by Identity Tags from their wake-up conditions */
+	TMultiMap<FGameplayTag, FName> HibernatedFlowsByTag;
+
+	float HibernatedTime = 0.0f;
+
+public:
+	/* Destroys Root Flow instance waiting for an event, it will be restored from the SaveGame record once the event occurs
+	 * Saves memory and garbage collection time, if world contains many idle flows. See UFlowNode::CanHibernate
+	 * Returns false, if any of active nodes can't hibernate */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual bool HibernateRootFlow(UObject* Owner, UFlowAsset* TemplateAsset);
+
+	/* Hibernates every Root Flow that can hibernate, returns number of hibernated instances */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual int32 HibernateIdleRootFlows();
+
+	/* Restores hibernated Root Flow without waiting for its wake-up conditions */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void WakeUpRootFlow(UObject* Owner, UFlowAsset* TemplateAsset);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	bool IsRootFlowHibernated(const UObject* Owner, const UFlowAsset* TemplateAsset) const;
+
+	int32 GetNumHibernatedFlows() const { return HibernatedFlows.Num(); }
+
+	/* Time spent in hibernation by the instance being restored, in the time of its owner
+	 * Nodes can read it while loading, it's zero outside of waking up */
+	float GetHibernatedTime() const { return HibernatedTime; }
+
+protected:
+	bool HibernateInstance(UFlowAsset* AssetInstance);
+	void WakeUpInstance(const FName& InstanceName);
+	void RemoveHibernatedInstance(const FName& InstanceName);
+
+	FName FindHibernatedInstance(const UObject* Owner, const UFlowAsset* TemplateAsset) const;
+
+	/* Called before broadcasting component events, so restored nodes would receive them */
+	void WakeUpHibernatedFlows(const UFlowComponent* Component, const FGameplayTag& NotifyTag = FGameplayTag());
+
+	void OnWakeUpTimer(const FName InstanceName);
+
+//////////////////////////////////////////////////////////////////////////
+// Significance
+
+private:
+	struct FDeferredNotify
+	{
+		TWeakObjectPtr<UFlowComponent> Component;
+		FGameplayTag NotifyTag;
+	};
+
+	/* Notifies sent by throttled Flow Components, broadcasted in the next tick */
+	TArray<FDeferredNotify> DeferredNotifies;
+
+	float ThrottledTimersElapsed = 0.0f;
+
+public:
+	/* Timers of throttled owner are executed in batches, see UFlowComponent::SetSignificance
+	 * Deferred timers and notifies are executed immediately after removing throttling */
+	virtual void SetOwnerThrottled(const UObject* Owner, const bool bThrottled);
+	bool IsOwnerThrottled(const UObject* Owner) const { return TimerWheel.IsThrottled(Owner); }
+
+protected:
+	void DeferNotify(UFlowComponent* Component, const FGameplayTag& NotifyTag);
+
+	/* Broadcasts deferred notifies in the order they were sent, optionally only notifies of the given component */
+	void FlushDeferredNotifies(const UFlowComponent* OnlyComponent = nullptr);
+
+//////////////////////////////////////////////////////////////////////////
+// Notifies from any thread
+
+private:
+	FFlowNotifyQueueRef NotifyQueue;
+
+public:
+	/* Queue for sending notifies from other threads, keep the returned reference instead of the subsystem pointer
+	 * Has to be acquired on the game thread, i.e. before starting the async work */
+	FFlowNotifyQueueRef GetNotifyQueue() const { return NotifyQueue; }
+
+	/* See FFlowNotifyQueue, these require the subsystem to exist while queueing, so other threads should use GetNotifyQueue */
+	void QueueNotifyGraph(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+	void QueueNotifyActor(const TWeakObjectPtr<UFlowComponent>& Component, const FGameplayTag& ActorTag, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+	void QueueCustomInput(const TWeakObjectPtr<UFlowAsset>& FlowInstance, const FName& EventName);
+
+protected:
+	void FlushQueuedNotifies();
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame support
 
+public:
 	UPROPERTY(BlueprintAssignable, Category = "FlowSubsystem")
 	FSimpleFlowEvent OnSaveGame;
 
@@ -128,6 +381,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
 	virtual void OnGameLoaded(UFlowSaveGame* SaveGame);
 
+	/* Asynchronous save: the game thread captures Flow Graphs and Flow Components into the SaveGame by calling OnGameSaved
+	 * Compressing records and writing the serialized SaveGame to the slot happens on worker threads
+	 * SaveGame object is accessed only on the game thread, but its records are moved out while being compressed, so don't read it before OnCompleted
+	 * Compressed SaveGame keeps records in per-world blocks afterwards, these are decompressed on request
+	 * OnCompleted is called on the game thread once the slot has been written */
+	virtual void SaveGameToSlotAsync(UFlowSaveGame* SaveGame, const int32 UserIndex, const FFlowSaveGameCompleted& OnCompleted = FFlowSaveGameCompleted());
+
+	/* Returns true if any SaveGame is still being written by the background task */
+	bool IsSavingGame() const { return PendingSaveGames.Num() > 0; }
+
 	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
 	virtual void LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName);
 
@@ -137,6 +400,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
 	UFlowSaveGame* GetLoadedSaveGame() const { return LoadedSaveGame; }
 
+protected:
+	const FFlowAssetSaveData* FindInstanceRecord(UFlowAsset* FlowAsset, const FString& SavedAssetInstanceName) const;
+
+	void WriteSaveGameToSlot(UFlowSaveGame* SaveGame, const int32 UserIndex, const FFlowSaveGameCompleted& OnCompleted);
+	void OnSaveGameWritten(UFlowSaveGame* SaveGame, const bool bSuccess, const FFlowSaveGameCompleted& OnCompleted);
+
+protected:
+	/* SaveGames captured by SaveGameToSlotAsync, kept alive until the background task writes them */
+	UPROPERTY(Transient)
+	TArray<UFlowSaveGame*> PendingSaveGames;
+
+	TArray<UE::Tasks::FTask> PendingSaveTasks;
+
 //////////////////////////////////////////////////////////////////////////
 // Component Registry
 
@@ -144,6 +420,33 @@ protected:
 	/* All the Flow Components currently existing in the world */
 	TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>> FlowComponentRegistry;
 
+private:
+	/* Copy of the registry published for other threads, replaced as a whole
+	 * Readers load the raw pointer, so the replaced snapshot is kept until readers of the previous epoch are gone */
+	TSharedPtr<const FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe> RegistrySnapshot;
+	TSharedPtr<const FFlowComponentRegistrySnapshot, ESPMode::ThreadSafe> RetiredRegistrySnapshot;
+	std::atomic<const FFlowComponentRegistrySnapshot*> PublishedRegistrySnapshot;
+
+	/* Incremented by every publish, readers are counted separately for odd and even epochs */
+	std::atomic<uint32> RegistrySnapshotEpoch;
+	mutable std::atomic<int32> RegistrySnapshotReaders[2];
+
+	bool bRegistrySnapshotDirty = false;
+
+public:
+	/* Safe to call from any thread, i.e. from AI tasks. Returned snapshot never changes, it can be kept as long as needed
+	 * Lock-free, reader only announces itself in the current epoch while adding the reference to the published snapshot
+	 * Changes of the registry are published once per frame, in the subsystem tick */
+	FFlowComponentRegistrySnapshotRef GetRegistrySnapshot() const;
+
+protected:
+	/* Called from Tick, if the registry changed since the last publish
+	 * Snapshot replaced by the previous publish is released here, waiting only for readers still copying its pointer */
+	virtual void PublishRegistrySnapshot();
+
+private:
+	void ReleaseRetiredRegistrySnapshot();
+
 protected:
 	virtual void RegisterComponent(UFlowComponent* Component);
 	virtual void OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag);
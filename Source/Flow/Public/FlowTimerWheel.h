@@ -0,0 +1,177 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "UObject/ObjectKey.h"
+
+DECLARE_DELEGATE(FFlowTimerDelegate);
+
+/**
+ * Identifies timer registered in the Flow Timer Wheel
+ * Handle becomes stale once the timer is cleared or completed, it's safe to keep and clear stale handles
+ */
+struct FLOW_API FFlowTimerHandle
+{
+	friend class FFlowTimerWheel;
+
+	FFlowTimerHandle()
+		: Index(INDEX_NONE)
+		, Serial(0)
+	{
+	}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; }
+
+	bool operator==(const FFlowTimerHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FFlowTimerHandle& Other) const { return !(*this == Other); }
+
+private:
+	int32 Index;
+	uint32 Serial;
+};
+
+/**
+ * Hierarchical timer wheel ticked by the Flow Subsystem
+ * - cheap alternative to FTimerManager for large amounts of gameplay timers, i.e. every ambient NPC running Timer nodes
+ * - inserting and clearing timer is O(1), advancing time costs O(1) per tick plus the number of fired timers
+ * - timers are grouped by owner, every owner can have its own time dilation
+ * - remaining time is tracked precisely, so saving and restoring timer is a single call
+ * - calls of throttled owners' timers are deferred and executed in batches, in the original order
+ * Times passed to and returned from the wheel are expressed in owner's time, i.e. already dilated
+ */
+class FLOW_API FFlowTimerWheel
+{
+public:
+	FFlowTimerWheel();
+
+	/**
+	 * Registers new timer
+	 * @param Owner Object used to group timers, i.e. for applying time dilation. Can be null.
+	 * @param Rate Time between calls, in owner's time
+	 * @param bLoop If true, timer will keep calling delegate until it's cleared
+	 * @param FirstDelay Time until first call, Rate is used if value is negative
+	 */
+	FFlowTimerHandle SetTimer(const UObject* Owner, const FFlowTimerDelegate& Delegate, const float Rate, const bool bLoop, const float FirstDelay = -1.0f);
+
+	/* Delegate will be called on the next Advance() */
+	FFlowTimerHandle SetTimerForNextTick(const UObject* Owner, const FFlowTimerDelegate& Delegate);
+
+	/* Stops the timer and invalidates the handle */
+	void ClearTimer(FFlowTimerHandle& Handle);
+
+	/* Stops all timers of given owner, cost is proportional to the number of all timers */
+	void ClearAllTimers(const UObject* Owner);
+
+	/* Stops all timers of given owners and removes their settings, single pass over all timers */
+	void ClearAllTimers(const TSet<TObjectKey<UObject>>& Owners);
+
+	bool IsTimerActive(const FFlowTimerHandle& Handle) const;
+
+	/* Returns time left until the next call in owner's time, or -1 if timer isn't active */
+	float GetTimerRemaining(const FFlowTimerHandle& Handle) const;
+
+	/* Returns time passed since the timer was set or last called in owner's time, or -1 if timer isn't active */
+	float GetTimerElapsed(const FFlowTimerHandle& Handle) const;
+
+	/* Dilation of 0 pauses all timers of given owner, cost is proportional to the number of all timers */
+	void SetTimeDilation(const UObject* Owner, const float TimeDilation);
+	float GetTimeDilation(const UObject* Owner) const;
+
+	/* Expired timers of throttled owner are called by the next FlushThrottledTimers(), instead of immediately
+	 * Deferred calls of the owner are executed immediately after removing throttling */
+	void SetThrottled(const UObject* Owner, const bool bThrottled);
+	bool IsThrottled(const UObject* Owner) const;
+
+	/* Removes throttling without executing deferred calls of the owner, i.e. if the owner is going away
+	 * Expired timers waiting for their calls are removed, looping timers keep running */
+	void ClearThrottled(const UObject* Owner);
+
+	/* Executes all deferred calls of throttled owners, in the order of timers expiring */
+	void FlushThrottledTimers();
+
+	/* Moves time forward and calls delegates of expired timers */
+	void Advance(const float DeltaSeconds);
+
+	/* Removes all timers and owner settings */
+	void Reset();
+
+	int32 GetNumTimers() const { return NumActiveTimers; }
+
+private:
+	struct FTimer
+	{
+		FFlowTimerDelegate Delegate;
+		TObjectKey<UObject> Owner;
+
+		// in wheel time, meaning the time not dilated by the owner
+		double ExpireTime = 0.0;
+		uint64 ExpireTick = 0;
+
+		// in owner's time
+		float Rate = 0.0f;
+		float CycleDuration = 0.0f;
+		float PausedRemaining = 0.0f;
+
+		uint32 Serial = 0;
+		int32 Bucket = INDEX_NONE;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		bool bLoop = false;
+		bool bAllocated = false;
+	};
+
+	static constexpr int32 Level0Bits = 8;
+	static constexpr int32 LevelBits = 6;
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 Level0Slots = 1 << Level0Bits;
+	static constexpr int32 LevelSlots = 1 << LevelBits;
+	static constexpr double TickDuration = 1.0 / 60.0;
+
+	// special buckets placed after the wheel slots
+	static constexpr int32 NextTickBucket = Level0Slots + (NumLevels - 1) * LevelSlots;
+	static constexpr int32 FiringBucket = NextTickBucket + 1;
+	static constexpr int32 NumBuckets = FiringBucket + 1;
+
+	// expired timer waiting for the deferred call, it's not linked to any list
+	static constexpr int32 DeferredBucket = NumBuckets;
+
+	struct FDeferredCall
+	{
+		int32 Index;
+		uint32 Serial;
+	};
+
+	TArray<FTimer> Timers;
+	TArray<int32> FreeIndexes;
+	TArray<int32> BucketHeads;
+
+	TMap<TObjectKey<UObject>, float> OwnerTimeDilations;
+
+	TSet<TObjectKey<UObject>> ThrottledOwners;
+	TArray<FDeferredCall> DeferredCalls;
+
+	double CurrentTime;
+	uint64 CurrentTick;
+	uint32 NextSerial;
+	int32 NumActiveTimers;
+
+	FTimer* FindTimer(const FFlowTimerHandle& Handle);
+	const FTimer* FindTimer(const FFlowTimerHandle& Handle) const;
+
+	int32 AllocateTimer();
+	void FreeTimer(const int32 Index);
+
+	void Schedule(const int32 Index, const float OwnerDelay, const float TimeDilation);
+	void Link(const int32 Index, const int32 Bucket);
+	void Unlink(const int32 Index);
+	void LinkToWheel(const int32 Index);
+
+	void Cascade(const int32 Level, const int32 Slot);
+	void FireBucket(const int32 Bucket);
+	void ExecuteDeferredCall(const FDeferredCall& DeferredCall);
+
+	float GetTimeDilation(const TObjectKey<UObject>& OwnerKey) const;
+	float GetRemaining(const FTimer& Timer) const;
+};
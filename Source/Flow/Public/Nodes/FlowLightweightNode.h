@@ -0,0 +1,33 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+
+class UFlowAsset;
+
+/**
+ * Passed to UFlowNode::ExecuteLightweight, when node is executed without creating the node instance
+ * Node logic runs on the template node, the only per-instance data is the State owned by the Flow Asset instance
+ */
+struct FLOW_API FFlowLightweightNodeContext
+{
+private:
+	UFlowAsset& FlowAsset;
+	const int32 NodeIndex;
+
+public:
+	// Node state, zeroed or set by UFlowNode::InitializeLightweightState until the node changes it
+	// Read it again after triggering outputs, as signal might come back to this node
+	const TArrayView<int32> State;
+
+	FFlowLightweightNodeContext(UFlowAsset& InFlowAsset, const int32 InNodeIndex, const TArrayView<int32> InState)
+		: FlowAsset(InFlowAsset)
+		, NodeIndex(InNodeIndex)
+		, State(InState)
+	{
+	}
+
+	// Node has no instance to Finish, so it needs to restore its state before triggering the final output
+	void TriggerOutput(const FName& PinName) const;
+};
@@ -5,6 +5,7 @@
 #include "EdGraph/EdGraphNode.h"
 #include "GameplayTagContainer.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
 #include "VisualLogger/VisualLoggerDebugSnapshotInterface.h"
 
 #include "FlowMessageLog.h"
@@ -15,12 +16,35 @@
 class IFlowOwnerInterface;
 class UFlowAsset;
 class UFlowSubsystem;
+struct FFlowCompiledGraph;
+struct FFlowLightweightNodeContext;
 struct FFlowNodeSaveData;
+struct FFlowWakeUpConditions;
 
 #if WITH_EDITOR
 DECLARE_DELEGATE(FFlowNodeEvent);
 #endif
 
+// Blueprint events called by the Flow Node during gameplay
+// Used to skip calling events that aren't implemented by the node class
+enum class EFlowNodeBlueprintEvent : uint16
+{
+	None = 0,
+	InitializeInstance = 1 << 0,
+	PreloadContent = 1 << 1,
+	FlushContent = 1 << 2,
+	OnActivate = 1 << 3,
+	ExecuteInput = 1 << 4,
+	Cleanup = 1 << 5,
+	DeinitializeInstance = 1 << 6,
+	ForceFinishNode = 1 << 7,
+	OnSave = 1 << 8,
+	OnLoad = 1 << 9,
+	OnPassThrough = 1 << 10,
+	All = 0x07FF
+};
+ENUM_CLASS_FLAGS(EFlowNodeBlueprintEvent)
+
 /**
  * A Flow Node is UObject-based node designed to handle entire gameplay feature within single node.
  */
@@ -35,6 +59,10 @@ class FLOW_API UFlowNode : public UObject, public IVisualLoggerDebugSnapshotInte
 	friend class SFlowInputPinHandle;
 	friend class SFlowOutputPinHandle;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FFlowTestFixture;
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 // Node
 
@@ -137,10 +165,13 @@ public:
 	IFlowOwnerInterface* GetFlowOwnerInterface() const;
 
 protected:
+	// Resolve owner context directly, used if the Flow Asset instance didn't cache it
+	static AActor* TryGetActorOwner(UObject* RootFlowOwner);
+	static IFlowOwnerInterface* TryGetFlowOwnerInterface(UObject* RootFlowOwner, const UClass* ExpectedOwnerClass);
 
 	// Helper functions for GetFlowOwnerInterface()
-	IFlowOwnerInterface* TryGetFlowOwnerInterfaceFromRootFlowOwner(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass) const;
-	IFlowOwnerInterface* TryGetFlowOwnerInterfaceActor(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass) const;
+	static IFlowOwnerInterface* TryGetFlowOwnerInterfaceFromRootFlowOwner(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass);
+	static IFlowOwnerInterface* TryGetFlowOwnerInterfaceActor(UObject& RootFlowOwner, const UClass& ExpectedOwnerClass);
 
 	// Gets the Owning Object for this Node's RootFlow
 	UObject* TryGetRootFlowObjectOwner() const;
@@ -148,6 +179,15 @@ protected:
 public:	
 	virtual bool CanFinishGraph() const { return false; }
 
+	// Node does nothing except passing signal from its input to the first output, like Reroute
+	// Outside of the editor, signals skip such nodes and these aren't instanced
+	virtual bool IsPurePassThrough() const { return false; }
+
+	// Graph can be entered by this node without any incoming connection, like Start or Custom Input
+	// Override it for nodes with input pins, if these are also triggered from outside of the graph
+	// Nodes not reachable from any entry node are removed from cooked Flow Asset
+	virtual bool IsEntryNode() const { return InputPins.Num() == 0; }
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "FlowNode")
 	TArray<EFlowSignalMode> AllowedSignalModes;
@@ -228,9 +268,29 @@ protected:
 	UPROPERTY()
 	TMap<FName, FConnectedPin> Connections;
 
+	// Outputs connected to multiple inputs, the first input is stored in Connections
+	// Signal is passed to the input from Connections first, then to these inputs in order
+	UPROPERTY()
+	TMap<FName, FConnectedPins> FanOutConnections;
+
+private:
+	// Index of this node in the compiled graph of Flow Asset, only set on node instances
+	int32 CompiledIndex;
+
+	// Cooked nodes don't keep connections, these are read from the compiled graph
+	const FFlowCompiledGraph* FindCompiledConnections(int32& OutNodeIndex) const;
+
 public:
+	// Connections are compiled into the graph of Flow Asset while saving it, node instances pass signals only through the compiled graph
+	// Changing connections of node instance has no effect, call UFlowAsset::CompileGraph on the template after editing its nodes
 	void SetConnections(const TMap<FName, FConnectedPin>& InConnections) { Connections = InConnections; }
-	FConnectedPin GetConnection(const FName OutputName) const { return Connections.FindRef(OutputName); }
+	void SetFanOutConnections(const TMap<FName, FConnectedPins>& InFanOutConnections) { FanOutConnections = InFanOutConnections; }
+
+	// Returns the first input connected to the output
+	FConnectedPin GetConnection(const FName OutputName) const;
+
+	// Appends all inputs connected to the output, in order of passing the signal
+	void GetConnections(const FName& OutputName, TArray<FConnectedPin>& OutConnections) const;
 
 	UFUNCTION(BlueprintPure, Category= "FlowNode")
 	TSet<UFlowNode*> GetConnectedNodes() const;
@@ -273,6 +333,23 @@ private:
 	TMap<FName, TArray<FPinRecord>> OutputRecords;
 #endif
 
+private:
+	// Blueprint events implemented by the class of this node, resolved while initializing the instance
+	// Nodes that weren't initialized call all events
+	EFlowNodeBlueprintEvent ImplementedBlueprintEvents;
+
+	// Resolving events requires a function lookup, so it's done once per class
+	static TMap<TObjectKey<UClass>, EFlowNodeBlueprintEvent> ImplementedBlueprintEventsPerClass;
+
+	void CacheImplementedBlueprintEvents();
+
+protected:
+	bool IsBlueprintEventImplemented(const EFlowNodeBlueprintEvent Event) const { return EnumHasAnyFlags(ImplementedBlueprintEvents, Event); }
+
+public:
+	// Called after recompiling Blueprints or reloading classes
+	static void ResetImplementedBlueprintEvents();
+
 public:
 	UFUNCTION(BlueprintPure, Category = "FlowNode")
 	UFlowSubsystem* GetFlowSubsystem() const;
@@ -332,6 +409,12 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "FlowNode", meta = (HidePin = "ActivationType"))
 	void TriggerOutputPin(const FFlowOutputPinHandle Pin, const bool bFinish = false, const EFlowPinActivationType ActivationType = EFlowPinActivationType::Default);
 
+	// Same as TriggerOutput, but inputs of excluded nodes aren't triggered, i.e. nodes connected to this output executed it before
+	void TriggerOutputExcludingNodes(const FName& PinName, const TSet<FGuid>& ExcludedNodes);
+
+private:
+	void TriggerOutput_Internal(const FName& PinName, const bool bFinish, const EFlowPinActivationType ActivationType, const TSet<FGuid>* ExcludedNodes);
+
 public:
 	// Finish execution of node, it will call Cleanup
 	UFUNCTION(BlueprintCallable, Category = "FlowNode")
@@ -366,6 +449,20 @@ protected:
 private:
 	void ResetRecords();
 
+//////////////////////////////////////////////////////////////////////////
+// Lightweight execution, enabled by UFlowSettings::bLightweightRouteNodes
+
+public:
+	// Number of int32 values needed to store the state of node executed without the node instance
+	// INDEX_NONE means that node requires its own instance
+	virtual int32 GetLightweightStateSize() const { return INDEX_NONE; }
+
+	// Called on the template node while initializing the Flow Asset instance, or resetting state loaded from the incompatible SaveGame
+	virtual void InitializeLightweightState(const TArrayView<int32> State) const {}
+
+	// Lightweight equivalent of ExecuteInput, called on the template node
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const {}
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame support
 
@@ -385,6 +482,11 @@ protected:
 
 	UFUNCTION(BlueprintNativeEvent, Category = "FlowNode")
 	void OnPassThrough();
+
+public:
+	// Returns true if active node only waits for an event, and it can be restored from the SaveGame record once the event occurs
+	// This allows UFlowSubsystem::HibernateRootFlow to destroy the Flow Asset instance until one of its nodes needs to wake up
+	virtual bool CanHibernate(FFlowWakeUpConditions& OutConditions) const { return false; }
 	
 //////////////////////////////////////////////////////////////////////////
 // Utils
@@ -0,0 +1,88 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+#include "Nodes/FlowNode.h"
+#include "FlowNode_AsyncBase.generated.h"
+
+/**
+ * Base class for nodes doing expensive work outside of the game thread, i.e. querying data tables or building dialogue options
+ * - work runs as UE::Tasks task and receives only the payload copied on the game thread, it must not touch UObjects
+ * - result is passed to the completion callback on the game thread, only if the node still waits for this work
+ * - node waits for a single work at the time, launching new work discards the result of the previous one
+ * - Cleanup discards the result of work in flight, the task itself isn't stopped
+ * - work in flight isn't saved, loaded node calls RestartAsyncWork instead, which executes the launching input again
+ */
+UCLASS(Abstract, NotBlueprintable)
+class FLOW_API UFlowNode_AsyncBase : public UFlowNode
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	UPROPERTY(SaveGame)
+	bool bAsyncWorkPending;
+
+	/* Input that launched the pending work */
+	UPROPERTY(SaveGame)
+	FName AsyncWorkInputPin;
+
+	uint32 PendingWorkSerial;
+	uint32 LastWorkSerial;
+
+public:
+	bool IsAsyncWorkPending() const { return bAsyncWorkPending; }
+
+protected:
+	/**
+	 * Launches work on the worker thread, then calls OnCompleted on the game thread
+	 * @param InputPin Input executed by this call, it's executed again if the node is loaded while waiting for the work
+	 * @param Payload Copied into the task, it's the only input of the work
+	 * @param Work Callable taking const Payload& and returning the result, it must not capture the node
+	 * @param OnCompleted Callable taking the result by rvalue reference, i.e. triggering the output. Not called if work has been cancelled.
+	 * @return Task finished once the completion is queued on the game thread
+	 */
+	template <typename PayloadType, typename WorkType, typename CompletionType>
+	UE::Tasks::FTask LaunchAsyncWork(const FName& InputPin, PayloadType&& Payload, WorkType&& Work, CompletionType&& OnCompleted)
+	{
+		using FPayload = typename TDecay<PayloadType>::Type;
+		using FResult = typename TDecay<decltype(Invoke(Work, DeclVal<const FPayload&>()))>::Type;
+
+		const uint32 WorkSerial = StartAsyncWork(InputPin);
+		const TWeakObjectPtr<UFlowNode_AsyncBase> WeakThis(this);
+
+		return UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, WorkSerial, Payload = FPayload(Forward<PayloadType>(Payload)), Work = Forward<WorkType>(Work), OnCompleted = Forward<CompletionType>(OnCompleted)]() mutable
+		{
+			FResult Result = Invoke(Work, static_cast<const FPayload&>(Payload));
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, WorkSerial, Result = MoveTemp(Result), OnCompleted = MoveTemp(OnCompleted)]() mutable
+			{
+				UFlowNode_AsyncBase* Node = WeakThis.Get();
+				if (Node && Node->CompleteAsyncWork(WorkSerial))
+				{
+					Invoke(OnCompleted, MoveTemp(Result));
+				}
+			});
+		});
+	}
+
+	/* Result of the work in flight will be discarded */
+	void CancelAsyncWork();
+
+	/* Called after loading node that was waiting for the work, default implementation executes the input that launched the work */
+	virtual void RestartAsyncWork();
+
+	virtual void Cleanup() override;
+	virtual void OnLoad_Implementation() override;
+
+private:
+	uint32 StartAsyncWork(const FName& InputPin);
+	bool CompleteAsyncWork(const uint32 WorkSerial);
+
+#if WITH_EDITOR
+public:
+	virtual FString GetStatusString() const override;
+#endif
+};
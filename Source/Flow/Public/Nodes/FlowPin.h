@@ -13,12 +13,15 @@ struct FLOW_API FFlowPin
 	UPROPERTY(EditDefaultsOnly, Category = "FlowPin")
 	FName PinName;
 
+#if WITH_EDITORONLY_DATA
 	// An optional Display Name, you can use it to override PinName without the need to update graph connections
+	// Display data is used only by the graph editor, so it's not copied to every node instance in cooked game
 	UPROPERTY(EditDefaultsOnly, Category = "FlowPin")
 	FText PinFriendlyName;
 
 	UPROPERTY(EditDefaultsOnly, Category = "FlowPin")
 	FString PinToolTip;
+#endif
 
 	static inline FName AnyPinName = TEXT("AnyPinName");
 
@@ -59,21 +62,27 @@ struct FLOW_API FFlowPin
 
 	FFlowPin(const FStringView InPinName, const FText& InPinFriendlyName)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
 	{
+#if WITH_EDITORONLY_DATA
+		PinFriendlyName = InPinFriendlyName;
+#endif
 	}
 
 	FFlowPin(const FStringView InPinName, const FString& InPinTooltip)
 		: PinName(InPinName)
-		, PinToolTip(InPinTooltip)
 	{
+#if WITH_EDITORONLY_DATA
+		PinToolTip = InPinTooltip;
+#endif
 	}
 
 	FFlowPin(const FStringView InPinName, const FText& InPinFriendlyName, const FString& InPinTooltip)
 		: PinName(InPinName)
-		, PinFriendlyName(InPinFriendlyName)
-		, PinToolTip(InPinTooltip)
 	{
+#if WITH_EDITORONLY_DATA
+		PinFriendlyName = InPinFriendlyName;
+		PinToolTip = InPinTooltip;
+#endif
 	}
 
 	FORCEINLINE bool IsValid() const
@@ -182,6 +191,26 @@ struct FLOW_API FConnectedPin
 	}
 };
 
+// Further inputs connected to the single output pin, in the order of linking pins in the graph
+USTRUCT()
+struct FLOW_API FConnectedPins
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<FConnectedPin> Pins;
+
+	FORCEINLINE bool operator==(const FConnectedPins& Other) const
+	{
+		return Pins == Other.Pins;
+	}
+
+	FORCEINLINE bool operator!=(const FConnectedPins& Other) const
+	{
+		return Pins != Other.Pins;
+	}
+};
+
 UENUM(BlueprintType)
 enum class EFlowPinActivationType : uint8
 {
@@ -14,16 +14,32 @@ class FLOW_API UFlowNode_LogicalAND final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 
+	// Executed inputs are stored as bits of a single value
+	static constexpr int32 MaxInputs = 64;
+
 private:
+	// Bit per input pin, set after executing the pin
+	UPROPERTY(SaveGame)
+	uint64 ExecutedInputs;
+
+	// Layout used by SaveGames written before switching to ExecutedInputs, converted in OnLoad
 	UPROPERTY(SaveGame)
 	TSet<FName> ExecutedInputNames;
 	
 #if WITH_EDITOR
 public:
-	virtual bool CanUserAddInput() const override { return true; }
+	virtual bool CanUserAddInput() const override { return InputPins.Num() < MaxInputs; }
+	virtual EDataValidationResult ValidateNode() override;
 #endif
 
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void OnLoad_Implementation() override;
 	virtual void Cleanup() override;
+
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
+
+private:
+	uint64 GetAllInputsMask() const;
 };
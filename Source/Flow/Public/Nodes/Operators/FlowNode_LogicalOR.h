@@ -37,4 +37,8 @@ protected:
 	virtual void Cleanup() override;
 
 	void ResetCounter();
+
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void InitializeLightweightState(const TArrayView<int32> State) const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
 };
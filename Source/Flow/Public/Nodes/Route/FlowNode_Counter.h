@@ -25,6 +25,9 @@ protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 	virtual void Cleanup() override;
 
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
+
 #if WITH_EDITOR
 	virtual FString GetNodeDescription() const override;
 	virtual FString GetStatusString() const override;
@@ -24,23 +24,44 @@ class FLOW_API UFlowNode_ExecutionMultiGate final : public UFlowNode
 	UPROPERTY(EditAnywhere, Category = "MultiGate")
 	int32 StartIndex;
 
+	// Completed outputs are stored as bits of a single value
+	static constexpr int32 MaxOutputs = 64;
+
+	// Lightweight state holds completed outputs in a single int32, see UFlowSettings::bLightweightRouteNodes
+	// Node with more outputs is always executed by its instance, which supports up to MaxOutputs
+	static constexpr int32 MaxLightweightOutputs = 32;
+
 private:
 	UPROPERTY(SaveGame)
 	int32 NextOutput;
 
+	// Bit per output pin, set after triggering the pin
+	UPROPERTY(SaveGame)
+	uint64 CompletedOutputs;
+
+	// Layout used by SaveGames written before switching to CompletedOutputs, converted in OnLoad
 	UPROPERTY(SaveGame)
 	TArray<bool> Completed;
 
 public:
 #if WITH_EDITOR
-	virtual bool CanUserAddOutput() const override { return true; }
+	virtual bool CanUserAddOutput() const override { return OutputPins.Num() < MaxOutputs; }
+	virtual EDataValidationResult ValidateNode() override;
 #endif
 
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void OnLoad_Implementation() override;
 	virtual void Cleanup() override;
 
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
+
 #if WITH_EDITOR
 	virtual FString GetNodeDescription() const override;
 #endif
+
+private:
+	// Returns index of the N-th set bit, in constant number of steps
+	static int32 FindNthAvailableOutput(uint64 AvailableOutputs, int32 N);
 };
@@ -41,6 +41,9 @@ protected:
 
 	void ExecuteNewConnections();
 
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
+
 #if WITH_EDITOR
 public:
 	virtual FString GetNodeDescription() const override;
@@ -13,6 +13,12 @@ class FLOW_API UFlowNode_Reroute final : public UFlowNode
 {
 	GENERATED_UCLASS_BODY()
 	
+public:
+	virtual bool IsPurePassThrough() const override { return true; }
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
+
+	virtual int32 GetLightweightStateSize() const override;
+	virtual void ExecuteLightweight(const FFlowLightweightNodeContext& Context, const FName& PinName) const override;
 };
@@ -17,6 +17,10 @@ class FLOW_API UFlowNode_SubGraph : public UFlowNode
 	friend class FFlowNode_SubGraphDetails;
 	friend class UFlowSubsystem;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FFlowTestFixture;
+#endif
+
 	static FFlowPin StartPin;
 	static FFlowPin FinishPin;
 	
@@ -34,6 +38,14 @@ private:
 	UPROPERTY(SaveGame)
 	FString SavedAssetInstanceName;
 
+	// Set while cooking, if nodes of the Sub Graph asset were copied into the asset containing this node
+	UPROPERTY()
+	FGuid InlinedEntryNodeGuid;
+
+public:
+	bool IsInlined() const { return InlinedEntryNodeGuid.IsValid(); }
+	FSoftObjectPath GetAssetPath() const { return Asset.ToSoftObjectPath(); }
+
 protected:
 	virtual bool CanBeAssetInstanced() const;
 	
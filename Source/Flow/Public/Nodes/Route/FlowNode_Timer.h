@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "Engine/EngineTypes.h"
+#include "FlowTimerWheel.h"
 #include "Nodes/FlowNode.h"
 #include "FlowNode_Timer.generated.h"
 
@@ -24,8 +24,8 @@ protected:
 	float StepTime;
 
 private:
-	FTimerHandle CompletionTimerHandle;
-	FTimerHandle StepTimerHandle;
+	FFlowTimerHandle CompletionTimerHandle;
+	FFlowTimerHandle StepTimerHandle;
 
 	UPROPERTY(SaveGame)
 	float SumOfSteps;
@@ -36,17 +36,21 @@ private:
 	UPROPERTY(SaveGame)
 	float RemainingStepTime;
 
+	// Expired timer waiting for its call has no remaining time, but it still has to be restored
+	UPROPERTY(SaveGame)
+	bool bCompletionTimerActive;
+
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
 
 	virtual void SetTimer();
 	virtual void Restart();
-	
+
+	// Timers are grouped by this object in the Flow Timer Wheel, i.e. for applying time dilation
+	virtual UObject* GetTimerOwner() const;
+
 private:
-	UFUNCTION()
 	void OnStep();
-
-	UFUNCTION()
 	void OnCompletion();
 
 protected:
@@ -54,6 +58,9 @@ protected:
 
 	virtual void OnSave_Implementation() override;
 	virtual void OnLoad_Implementation() override;
+
+public:
+	virtual bool CanHibernate(FFlowWakeUpConditions& OutConditions) const override;
 	
 #if WITH_EDITOR
 	virtual FString GetNodeDescription() const override;
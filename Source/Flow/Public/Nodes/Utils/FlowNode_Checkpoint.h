@@ -5,8 +5,14 @@
 #include "Nodes/FlowNode.h"
 #include "FlowNode_Checkpoint.generated.h"
 
+class UFlowSaveGame;
+
 /**
  * Save the state of the game to the save file
+ * The state is captured immediately and Out is triggered, writing the save file happens in the background
+ * Saved is triggered once the save file has been written, Failed if writing it failed
+ * If the graph finishes before the save file is written, neither Saved nor Failed is triggered
+ * Loading the checkpoint triggers Out and Saved, as the loaded state has been captured before triggering Out
  * It's recommended to replace this with game-specific variant and this node to UFlowGraphSettings::HiddenNodes
  */
 UCLASS(NotBlueprintable, meta = (DisplayName = "Checkpoint", Keywords = "autosave, save"))
@@ -16,5 +22,15 @@ class FLOW_API UFlowNode_Checkpoint final : public UFlowNode
 
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void Cleanup() override;
+	virtual void DeinitializeInstance() override;
+
 	virtual void OnLoad_Implementation() override;
+
+private:
+	// SaveGame written in the background, node doesn't react on completing other saves
+	TWeakObjectPtr<UFlowSaveGame> PendingSaveGame;
+
+	void OnSaveCompleted(UFlowSaveGame* SaveGame, const bool bSuccess);
+	void DiscardPendingSave();
 };
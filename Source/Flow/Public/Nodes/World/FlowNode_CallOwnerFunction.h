@@ -18,6 +18,7 @@ typedef TFunction<FName(UFlowOwnerFunctionParams* Params)> FFlowOwnerFunctionSig
  * - Owner must implement IFlowOwnerInterface
  * - Callable functions must take a single input parameter deriving from UFlowOwnerFunctionParams
  *   and return FName for the Output event to trigger (or "None" to trigger none of the outputs)
+ * - C++ owners can skip ProcessEvent by registering native bindings with FLOW_REGISTER_OWNER_FUNCTION
  */
 UCLASS(NotBlueprintable, meta = (DisplayName = "Call Owner Function"))
 class FLOW_API UFlowNode_CallOwnerFunction : public UFlowNode
@@ -33,6 +34,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Call Owner", Instanced)
 	UFlowOwnerFunctionParams* Params;
 
+	// Names of output pins, gathered on the first execution
+	TArray<FName> ValidOutputNames;
+
 protected:
 	// UFlowNode
 	virtual void ExecuteInput(const FName& PinName) override;
@@ -67,6 +67,9 @@ protected:
 
 	virtual void Cleanup() override;
 
+public:
+	virtual bool CanHibernate(FFlowWakeUpConditions& OutConditions) const override;
+
 #if WITH_EDITOR
 public:
 	virtual FString GetNodeDescription() const override;
@@ -26,6 +26,9 @@ protected:
 	virtual void ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
 
 	virtual void OnNotifyFromComponent(UFlowComponent* Component, const FGameplayTag& Tag);
+
+public:
+	virtual bool CanHibernate(FFlowWakeUpConditions& OutConditions) const override;
 	
 #if WITH_EDITOR
 public:
@@ -66,14 +66,14 @@ void FFlowGraphConnectionDrawingPolicy::BuildPaths()
 			{
 				if (UEdGraphPin* OutputPin = FlowGraphNode->OutputPins[Record.Key])
 				{
-					// check if Output pin is connected to anything
-					if (OutputPin->LinkedTo.Num() > 0)
+					// signal is passed to all inputs connected to the Output pin
+					for (UEdGraphPin* LinkedPin : OutputPin->LinkedTo)
 					{
-						RecordedPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+						RecordedPaths.Emplace(OutputPin, LinkedPin);
 
 						if (CurrentTime < Record.Value.Time + RecentWireDuration)
 						{
-							RecentPaths.Emplace(OutputPin, OutputPin->LinkedTo[0]);
+							RecentPaths.Emplace(OutputPin, LinkedPin);
 						}
 					}
 				}
@@ -142,9 +142,20 @@ const FPinConnectionResponse UFlowGraphSchema::CanCreateConnection(const UEdGrap
 		return FPinConnectionResponse(CONNECT_RESPONSE_DISALLOW, TEXT("Directions are not compatible"));
 	}
 
-	// Break existing connections on outputs only - multiple input connections are acceptable
+	if (OutputPin->LinkedTo.Contains(InputPin))
+	{
+		return FPinConnectionResponse(CONNECT_RESPONSE_DISALLOW, TEXT("Pins are already connected"));
+	}
+
 	if (OutputPin->LinkedTo.Num() > 0)
 	{
+		// Output can be connected to multiple inputs, signal is passed to inputs in order of making connections
+		if (UFlowGraphSettings::Get()->bAllowOutputFanOut)
+		{
+			return FPinConnectionResponse(CONNECT_RESPONSE_MAKE, TEXT("Add connection, signal is passed to connected inputs in order of making connections"));
+		}
+
+		// Break existing connections on outputs only - multiple input connections are acceptable
 		const ECanCreateConnectionResponse ReplyBreakInputs = (OutputPin == PinA ? CONNECT_RESPONSE_BREAK_OTHERS_A : CONNECT_RESPONSE_BREAK_OTHERS_B);
 		return FPinConnectionResponse(ReplyBreakInputs, TEXT("Replace existing connections"));
 	}
@@ -48,6 +48,11 @@ class FLOWEDITOR_API UFlowGraphSettings : public UDeveloperSettings
 	UPROPERTY(EditAnywhere, config, Category = "Nodes")
 	TArray<TSubclassOf<class UFlowNode>> NodesHiddenFromPalette;
 
+	/** Allow connecting an output pin to multiple inputs, the signal is passed to inputs in order of making connections.
+	* If disabled, connecting an already connected output replaces its connection. */
+	UPROPERTY(EditAnywhere, config, Category = "Nodes")
+	bool bAllowOutputFanOut;
+
 	/** Hide default pin names on simple nodes, reduces UI clutter */
 	UPROPERTY(EditAnywhere, config, Category = "Nodes")
 	bool bShowDefaultPinNames;